@@ -306,6 +306,8 @@ ShellAppMainbsa(
   createDmaInfoTable();
   createSmbiosInfoTable();
   val_allocate_shared_mem();
+  if (PLATFORM_OVERRIDE_MEM_BENCHMARK)
+      pal_mem_benchmark();
 
   /* Initialise exception vector, so any unexpected exception gets handled
    *  by default BSA exception handler.
@@ -352,6 +354,7 @@ print_test_status:
   val_print(ACS_PRINT_ERR, "     -------------------------------------------------------\n", 0);
 
   freeBsaAcsMem();
+  pal_heap_report();
 
   val_print(ACS_PRINT_ERR, "\n      *** BSA tests complete. Reset the system. ***\n\n", 0);
 
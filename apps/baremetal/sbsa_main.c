@@ -422,6 +422,8 @@ ShellAppMainsbsa(
   createRas2InfoTable();
 
   val_allocate_shared_mem();
+  if (PLATFORM_OVERRIDE_MEM_BENCHMARK)
+      pal_mem_benchmark();
 
   /* Initialise exception vector, so any unexpected exception gets handled
    *  by default SBSA exception handler.
@@ -481,6 +483,7 @@ print_test_status:
   val_print(ACS_PRINT_ERR, "     ---------------------------------------------------------\n", 0);
 
   freeSbsaAvsMem();
+  pal_heap_report();
 
   val_print(ACS_PRINT_ERR, "\n      **  For complete SBSA test coverage, it is ", 0);
   val_print(ACS_PRINT_ERR, "\n            necessary to also run the BSA test    **\n\n", 0);
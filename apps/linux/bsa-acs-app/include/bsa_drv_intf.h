@@ -19,6 +19,7 @@
 #ifndef __BSA_DRV_INTF_H__
 #define __BSA_DRV_INTF_H__
 
+#include "acs_drv_intf.h"
 
 /* API NUMBERS to COMMUNICATE with DRIVER */
 
@@ -32,10 +33,6 @@
 #define BSA_FREE_INFO_TABLES        0x9000
 
 
-/* STATUS MESSAGES */
-#define DRV_STATUS_AVAILABLE     0x10000000
-#define DRV_STATUS_PENDING       0x40000000
-
 /* Function Prototypes */
 
 int
@@ -0,0 +1,243 @@
+/** @file
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include "include/acs_drv_intf.h"
+
+/* dev_fd value once /dev/<name> was found missing, use /proc from then on */
+#define ACS_DRV_USE_PROC    -2
+
+/**
+  @brief   Open /dev/<name> on first use. Older kernel modules only provide
+           /proc/<name>, in which case the handle falls back to it for good.
+  @param   drv    - Driver handle.
+
+  @return  1 if the character device is in use, 0 for the /proc interface.
+**/
+static int
+acs_drv_use_dev(acs_drv_t *drv)
+{
+    char path[ACS_DRV_PATH_LEN];
+
+    if (drv->dev_fd == -1) {
+        snprintf(path, sizeof(path), "/dev/%s", drv->name);
+        drv->dev_fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if (drv->dev_fd < 0)
+            drv->dev_fd = ACS_DRV_USE_PROC;
+    }
+
+    return (drv->dev_fd >= 0);
+}
+
+static int
+acs_drv_proc_open(acs_drv_t *drv, const char *suffix, int flags)
+{
+    char path[ACS_DRV_PATH_LEN];
+    int  fd;
+
+    snprintf(path, sizeof(path), "/proc/%s%s", drv->name, suffix);
+    fd = open(path, flags);
+    if (fd < 0)
+        printf("open %s failed\n", path);
+
+    return fd;
+}
+
+/**
+  @brief   Queue a request with the kernel module.
+  @param   drv    - Driver handle.
+  @param   parms  - Request to submit.
+
+  @return  0 on success, 1 on failure.
+**/
+int
+acs_drv_submit(acs_drv_t *drv, acs_drv_parms_t *parms)
+{
+    int fd;
+    int status = 0;
+
+    if (acs_drv_use_dev(drv)) {
+        if (ioctl(drv->dev_fd, ACS_DRV_IOC_SUBMIT, parms) < 0) {
+            printf("ioctl submit failed: %s\n", strerror(errno));
+            return 1;
+        }
+        return 0;
+    }
+
+    fd = acs_drv_proc_open(drv, "", O_RDWR);
+    if (fd < 0)
+        return 1;
+
+    if (write(fd, parms, sizeof(*parms)) != sizeof(*parms))
+        status = 1;
+
+    close(fd);
+    return status;
+}
+
+/**
+  @brief   Read the status record of the last submitted request.
+  @param   drv    - Driver handle.
+  @param   parms  - Filled with the status record.
+
+  @return  api_num field of the status record, 1 on failure.
+**/
+int
+acs_drv_get_status(acs_drv_t *drv, acs_drv_parms_t *parms)
+{
+    int fd;
+
+    memset(parms, 0, sizeof(*parms));
+
+    if (acs_drv_use_dev(drv)) {
+        if (ioctl(drv->dev_fd, ACS_DRV_IOC_STATUS, parms) < 0) {
+            printf("ioctl status failed: %s\n", strerror(errno));
+            return 1;
+        }
+        return parms->api_num;
+    }
+
+    fd = acs_drv_proc_open(drv, "", O_RDONLY);
+    if (fd < 0)
+        return 1;
+
+    if (read(fd, parms, sizeof(*parms)) < 0)
+        memset(parms, 0, sizeof(*parms));
+
+    close(fd);
+    return parms->api_num;
+}
+
+/**
+  @brief   Print all log records queued by the kernel module without
+           blocking.
+  @param   drv    - Driver handle.
+
+  @return  0 on success, 1 on failure.
+**/
+int
+acs_drv_read_msg(acs_drv_t *drv)
+{
+    acs_drv_msg_t msg[ACS_DRV_MSG_BATCH];
+    ssize_t       len;
+    int           fd, i;
+
+    if (acs_drv_use_dev(drv)) {
+        /* The device is non-blocking, read whole batches until EAGAIN */
+        while ((len = read(drv->dev_fd, msg, sizeof(msg))) > 0) {
+            for (i = 0; i < len / (ssize_t)sizeof(msg[0]); i++)
+                printf("%s", msg[i].string);
+        }
+        if ((len < 0) && (errno != EAGAIN) && (errno != EINTR)) {
+            printf("read messages failed: %s\n", strerror(errno));
+            return 1;
+        }
+        return 0;
+    }
+
+    fd = acs_drv_proc_open(drv, "_msg", O_RDONLY);
+    if (fd < 0)
+        return 1;
+
+    /* /proc hands out one record per read, print until buffer is empty */
+    while (read(fd, msg, sizeof(msg[0])) == sizeof(msg[0]))
+        printf("%s", msg[0].string);
+
+    close(fd);
+    return 0;
+}
+
+/**
+  @brief   Wait for the submitted request to complete, printing log records
+           as they arrive. With the character device the caller sleeps in
+           poll() until the module signals log data or completion. With
+           the /proc interface the status is re-read after a short sleep.
+  @param   drv    - Driver handle.
+
+  @return  arg1 of the final status record, the test result.
+**/
+unsigned long
+acs_drv_wait_for_completion(acs_drv_t *drv)
+{
+    acs_drv_parms_t parms;
+    struct pollfd   pfd;
+
+    parms.arg0 = DRV_STATUS_PENDING;
+    parms.arg1 = 0;
+
+    if (!acs_drv_use_dev(drv)) {
+        while (1) {
+            acs_drv_get_status(drv, &parms);
+            acs_drv_read_msg(drv);
+            if (parms.arg0 != DRV_STATUS_PENDING)
+                break;
+            usleep(ACS_DRV_PROC_POLL_US);
+        }
+        return parms.arg1;
+    }
+
+    pfd.fd     = drv->dev_fd;
+    pfd.events = POLLIN | POLLPRI;
+
+    while (1) {
+        pfd.revents = 0;
+        if ((poll(&pfd, 1, ACS_DRV_POLL_TIMEOUT_MS) < 0) && (errno != EINTR)) {
+            printf("poll failed: %s\n", strerror(errno));
+            break;
+        }
+
+        if (pfd.revents & POLLIN)
+            acs_drv_read_msg(drv);
+
+        /* Only log data, the request is still running */
+        if ((pfd.revents & POLLIN) && !(pfd.revents & (POLLPRI | POLLERR | POLLHUP)))
+            continue;
+
+        /* Completion event or timeout, confirm with the status record */
+        acs_drv_get_status(drv, &parms);
+        if (parms.arg0 != DRV_STATUS_PENDING)
+            break;
+
+        if (pfd.revents & (POLLERR | POLLHUP))
+            break;
+    }
+
+    /* Drain records logged just before completion */
+    acs_drv_read_msg(drv);
+    return parms.arg1;
+}
+
+/**
+  @brief   Close the character device if it was opened.
+  @param   drv    - Driver handle.
+
+  @return  None
+**/
+void
+acs_drv_close(acs_drv_t *drv)
+{
+    if (drv->dev_fd >= 0)
+        close(drv->dev_fd);
+
+    drv->dev_fd = -1;
+}
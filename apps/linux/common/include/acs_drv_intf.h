@@ -0,0 +1,94 @@
+/** @file
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **/
+
+
+#ifndef __ACS_DRV_INTF_H__
+#define __ACS_DRV_INTF_H__
+
+#include <sys/ioctl.h>
+
+/* STATUS MESSAGES */
+#define DRV_STATUS_AVAILABLE     0x10000000
+#define DRV_STATUS_PENDING       0x40000000
+
+/* Request passed to the ACS kernel module, shared by the bsa, sbsa and
+ * pcbsa modules. The layout matches what /proc/<name> accepts.
+ */
+typedef
+struct __ACS_DRV_PARMS__
+{
+    unsigned int    api_num;
+    unsigned int    num_pe;
+    unsigned int    level;
+    unsigned long   arg0;
+    unsigned long   arg1;
+    unsigned long   arg2;
+}acs_drv_parms_t;
+
+/* One log record, as returned by /proc/<name>_msg or read() on the device */
+typedef
+struct __ACS_DRV_MSG__
+{
+    char            string[92];
+    unsigned long   data;
+}acs_drv_msg_t;
+
+/* Character device interface, /dev/<name>
+ *  - ACS_DRV_IOC_SUBMIT queues a request.
+ *  - ACS_DRV_IOC_STATUS returns the current status record.
+ *  - read() returns whole acs_drv_msg_t records and blocks until one is
+ *    available unless the device is opened O_NONBLOCK.
+ *  - poll() reports POLLIN when log records are queued and POLLPRI once
+ *    the submitted request is no longer pending.
+ */
+#define ACS_DRV_IOC_MAGIC       'A'
+#define ACS_DRV_IOC_SUBMIT      _IOW(ACS_DRV_IOC_MAGIC, 1, acs_drv_parms_t)
+#define ACS_DRV_IOC_STATUS      _IOR(ACS_DRV_IOC_MAGIC, 2, acs_drv_parms_t)
+
+#define ACS_DRV_PATH_LEN        64
+#define ACS_DRV_MSG_BATCH       32     /* Log records fetched per read() */
+#define ACS_DRV_POLL_TIMEOUT_MS 1000   /* Re-check status if no event came */
+#define ACS_DRV_PROC_POLL_US    1000   /* Back-off between /proc status reads */
+
+/* Handle for one ACS kernel module, name is "bsa", "sbsa" or "pcbsa" */
+typedef
+struct __ACS_DRV__
+{
+    const char     *name;
+    int             dev_fd;     /* -1 until opened, -2 when /dev is absent */
+}acs_drv_t;
+
+#define ACS_DRV_INIT(drv_name)  { (drv_name), -1 }
+
+/* Function Prototypes */
+
+int
+acs_drv_submit(acs_drv_t *drv, acs_drv_parms_t *parms);
+
+int
+acs_drv_get_status(acs_drv_t *drv, acs_drv_parms_t *parms);
+
+int
+acs_drv_read_msg(acs_drv_t *drv);
+
+unsigned long
+acs_drv_wait_for_completion(acs_drv_t *drv);
+
+void
+acs_drv_close(acs_drv_t *drv);
+
+#endif
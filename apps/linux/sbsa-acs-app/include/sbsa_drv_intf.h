@@ -19,6 +19,7 @@
 #ifndef __SBSA_DRV_INTF_H__
 #define __SBSA_DRV_INTF_H__
 
+#include "acs_drv_intf.h"
 
 /* API NUMBERS to COMMUNICATE with DRIVER */
 
@@ -30,13 +31,6 @@
 #define SBSA_FREE_INFO_TABLES     0x9000
 
 
-/* STATUS MESSAGES */
-#define DRV_STATUS_AVAILABLE     0x10000000
-#define DRV_STATUS_PENDING       0x40000000
-
-
-
-
 /* Function Prototypes */
 
 int
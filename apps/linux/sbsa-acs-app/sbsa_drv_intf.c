@@ -24,129 +24,69 @@
 
 extern bool g_pcie_skip_dp_nic_ms;
 
-typedef
-struct __SBSA_DRV_PARMS__
-{
-    unsigned int    api_num;
-    unsigned int    num_pe;
-    unsigned int    level;
-    unsigned long   arg0;
-    unsigned long   arg1;
-    unsigned long   arg2;
-}sbsa_drv_parms_t;
+static acs_drv_t sbsa_drv = ACS_DRV_INIT("sbsa");
 
 
 int
 call_drv_get_status(unsigned long int *arg0, unsigned long int *arg1, unsigned long int *arg2)
 {
+    acs_drv_parms_t test_params;
+    int api_num;
 
-    FILE  *fd = NULL;
-    sbsa_drv_parms_t test_params;
-
-
-    fd = fopen("/proc/sbsa", "r");
-
-    if (NULL == fd)
-    {
-        printf("fopen failed\n");
-        return 1;
-    }
-  fread(&test_params,1,sizeof(test_params),fd);
-
-  //printf("read back value is %x %lx\n", test_params.api_num, test_params.arg1);
-
-  fclose(fd);
+    api_num = acs_drv_get_status(&sbsa_drv, &test_params);
 
-  *arg0 = test_params.arg0;
-  *arg1 = test_params.arg1;
-  *arg2 = test_params.arg2;
+    *arg0 = test_params.arg0;
+    *arg1 = test_params.arg1;
+    *arg2 = test_params.arg2;
 
-  return test_params.api_num;
+    return api_num;
 }
 
 int
 call_drv_wait_for_completion()
 {
-  unsigned long int arg0, arg1, arg2;
-
-  arg0 = DRV_STATUS_PENDING;
-
-  while (arg0 == DRV_STATUS_PENDING){
-    call_drv_get_status(&arg0, &arg1, &arg2);
-    read_from_proc_sbsa_msg();
-  }
-
-  return arg1;
+    return acs_drv_wait_for_completion(&sbsa_drv);
 }
 
 
 int
 call_drv_init_test_env(unsigned int print_level)
 {
-    FILE             *fd = NULL;
-    sbsa_drv_parms_t test_params;
-    int status = 0;
-
-    fd = fopen("/proc/sbsa", "rw+");
-
-    if (NULL == fd)
-    {
-        printf("fopen failed\n");
-        return 1;
-    }
+    acs_drv_parms_t test_params;
 
+    memset(&test_params, 0, sizeof(test_params));
     test_params.api_num  = SBSA_CREATE_INFO_TABLES;
     test_params.arg1     = print_level;
     test_params.arg2     = g_pcie_skip_dp_nic_ms;
 
-    fwrite(&test_params,1,sizeof(test_params),fd);
-
-    fclose(fd);
-
-    status = call_drv_wait_for_completion();
+    if (acs_drv_submit(&sbsa_drv, &test_params))
+        return 1;
 
-    return status;
+    return call_drv_wait_for_completion();
 }
 
 int
 call_drv_clean_test_env()
 {
-    FILE             *fd = NULL;
-    sbsa_drv_parms_t test_params;
-
-    fd = fopen("/proc/sbsa", "rw+");
-
-    if (NULL == fd)
-    {
-        printf("fopen failed\n");
-        return 1;
-    }
+    acs_drv_parms_t test_params;
 
+    memset(&test_params, 0, sizeof(test_params));
     test_params.api_num  = SBSA_FREE_INFO_TABLES;
-    test_params.arg1     = 0;
-    test_params.arg2     = 0;
 
-    fwrite(&test_params,1,sizeof(test_params),fd);
-
-    fclose(fd);
+    if (acs_drv_submit(&sbsa_drv, &test_params))
+        return 1;
 
     call_drv_wait_for_completion();
+    acs_drv_close(&sbsa_drv);
+
+    return 0;
 }
 
 int
 call_drv_execute_test(unsigned int api_num, unsigned int num_pe,
   unsigned int level, unsigned int print_level, unsigned long int test_input)
 {
-    FILE             *fd = NULL;
-    sbsa_drv_parms_t test_params;
-
-    fd = fopen("/proc/sbsa", "rw+");
-
-    if (NULL == fd)
-    {
-        printf("fopen failed\n");
-        return 1;
-    }
+    acs_drv_parms_t test_params;
 
     test_params.api_num  = api_num;
     test_params.num_pe   = num_pe;
@@ -155,25 +95,13 @@ call_drv_execute_test(unsigned int api_num, unsigned int num_pe,
     test_params.arg1     = print_level;
     test_params.arg2     = 0;
 
-    fwrite(&test_params,1,sizeof(test_params),fd);
-
-    fclose(fd);
-
+    return acs_drv_submit(&sbsa_drv, &test_params);
 }
 
 int
 call_update_skip_list(unsigned int api_num, int *p_skip_test_num)
 {
-    FILE             *fd = NULL;
-    sbsa_drv_parms_t test_params;
-
-    fd = fopen("/proc/sbsa", "rw+");
-
-    if (NULL == fd)
-    {
-        printf("fopen failed\n");
-        return 1;
-    }
+    acs_drv_parms_t test_params;
 
     test_params.api_num  = api_num;
     test_params.num_pe   = 0;
@@ -182,35 +110,10 @@ call_update_skip_list(unsigned int api_num, int *p_skip_test_num)
     test_params.arg1     = p_skip_test_num[1];
     test_params.arg2     = p_skip_test_num[2];
 
-    fwrite(&test_params,1,sizeof(test_params),fd);
-
-    fclose(fd);
-
+    return acs_drv_submit(&sbsa_drv, &test_params);
 }
 
-typedef struct __SBSA_MSG__ {
-    char string[92];
-    unsigned long data;
-}sbsa_msg_parms_t;
-
 int read_from_proc_sbsa_msg() {
 
-  char buf_msg[sizeof(sbsa_msg_parms_t)];
-
-  FILE  *fd = NULL;
-  sbsa_msg_parms_t msg_params;
-
-  fd = fopen("/proc/sbsa_msg", "r");
-
-  if (NULL == fd) {
-    printf("fopen failed\n");
-    return 1;
-  }
-
-  /* Print Until buffer is empty */
-  while(fread(buf_msg,sizeof(buf_msg),1,fd)){
-    printf("%s", buf_msg);
-  }
-
-  fclose(fd);
+  return acs_drv_read_msg(&sbsa_drv);
 }
@@ -25,6 +25,7 @@
 #include "val/include/acs_pe.h"
 #include "val/include/acs_val.h"
 #include "val/include/acs_memory.h"
+#include "val/include/acs_timer_support.h"
 
 #include "acs.h"
 
@@ -60,6 +61,15 @@ UINT32  g_num_modules = 0;
    of EL1 phy and virt timer, Below command line option is added only for debug
    purpose to complete BSA run on these systems */
 UINT32  g_el1physkip = FALSE;
+/* Keep secondary PEs parked between multi-PE payloads instead of
+   switching them off, see val_pe_pool_enable */
+UINT32  g_pe_pool = FALSE;
+/* Run the shared status record stress after setup, see val_shared_mem_stress */
+UINT32  g_shm_stress = FALSE;
+/* Stage log file output and write it in batches, see val_log_set_mode */
+UINT32  g_log_buffered = FALSE;
+/* Time the log sink modes after setup, see val_log_benchmark */
+UINT32  g_log_bench = FALSE;
 
 SHELL_FILE_HANDLE g_acs_log_file_handle;
 SHELL_FILE_HANDLE g_dtb_log_file_handle;
@@ -103,6 +113,10 @@ HelpMsg (
          "-dtb    Enable the execution of dtb dump\n"
          "-sbsa   Enable sbsa requirements for bsa binary\n"
          "-el1physkip Skips EL1 register checks\n"
+         "-pe_pool Keep secondary PEs parked between multi-PE tests\n"
+         "-shm_stress Stress the per-PE shared status records from all PEs\n"
+         "-log_buffer Write the log file in batches instead of once per print\n"
+         "-log_bench Time the log sink modes, requires -f\n"
          "-skip-dp-nic-ms Skip PCIe tests for DisplayPort, Network, and Mass Storage devices\n"
   );
 }
@@ -130,6 +144,10 @@ STATIC CONST SHELL_PARAM_ITEM ParamList[] = {
   {L"-no_crypto_ext", TypeFlag},  // -no_crypto_ext  # Skip tests which have export restrictions
   {L"-mmio", TypeFlag}, // -mmio # Enable pal_mmio prints
   {L"-el1physkip", TypeFlag}, // -el1physkip # Skips EL1 register checks
+  {L"-pe_pool", TypeFlag},   // -pe_pool # Park secondary PEs between tests
+  {L"-shm_stress", TypeFlag}, // -shm_stress # Stress per-PE shared status records
+  {L"-log_buffer", TypeFlag}, // -log_buffer # Batch log file writes
+  {L"-log_bench", TypeFlag},  // -log_bench # Time the log sink modes
   {NULL, TypeMax}
   };
 
@@ -457,6 +475,22 @@ command_init ()
   if (ShellCommandLineGetFlag (ParamPackage, L"-el1physkip")) {
     g_el1physkip = TRUE;
   }
+
+  if (ShellCommandLineGetFlag (ParamPackage, L"-pe_pool")) {
+    g_pe_pool = TRUE;
+  }
+
+  if (ShellCommandLineGetFlag (ParamPackage, L"-shm_stress")) {
+    g_shm_stress = TRUE;
+  }
+
+  if (ShellCommandLineGetFlag (ParamPackage, L"-log_buffer")) {
+    g_log_buffered = TRUE;
+  }
+
+  if (ShellCommandLineGetFlag (ParamPackage, L"-log_bench")) {
+    g_log_bench = TRUE;
+  }
   //
   // Initialize global counters
   //
@@ -485,16 +519,70 @@ STATIC VOID FlushImage (VOID)
 
 }
 
+/* Counter ticks spent in each *_create_info_table call, reported once the timer
+   info table provides the counter frequency */
+#define INFO_TABLE_TIME_MAX 16
+
+typedef struct {
+  CHAR8   *Name;
+  UINT64  Ticks;
+} INFO_TABLE_TIME;
+
+STATIC INFO_TABLE_TIME g_info_table_time[INFO_TABLE_TIME_MAX];
+STATIC UINT32          g_info_table_time_count;
+
+STATIC VOID
+recordInfoTableTime (
+  CHAR8   *Name,
+  UINT64  Start
+  )
+{
+  UINT64 End;
+
+  End = ArmReadCntPct();
+  if (g_info_table_time_count >= INFO_TABLE_TIME_MAX)
+    return;
+
+  g_info_table_time[g_info_table_time_count].Name  = Name;
+  g_info_table_time[g_info_table_time_count].Ticks = End - Start;
+  g_info_table_time_count++;
+}
+
+STATIC VOID
+printInfoTableTime (
+)
+{
+  UINT64 Freq;
+  UINT64 TotalTicks = 0;
+  UINT32 Index;
+
+  Freq = val_get_counter_frequency();
+  if (Freq == 0)
+    return;
+
+  val_print(ACS_PRINT_INFO, "\n Info table creation time (us)", 0);
+  for (Index = 0; Index < g_info_table_time_count; Index++) {
+    val_print(ACS_PRINT_INFO, "\n   ", 0);
+    val_print(ACS_PRINT_INFO, g_info_table_time[Index].Name, 0);
+    val_print(ACS_PRINT_INFO, " : %ld", (g_info_table_time[Index].Ticks * 1000000) / Freq);
+    TotalTicks += g_info_table_time[Index].Ticks;
+  }
+  val_print(ACS_PRINT_INFO, "\n   Total      : %ld\n", (TotalTicks * 1000000) / Freq);
+}
+
 UINT32
 createPeInfoTable (
 )
 {
   UINT32 Status;
   UINT64 *PeInfoTable;
+  UINT64 Start;
 
   PeInfoTable = val_aligned_alloc(SIZE_4K, PE_INFO_TBL_SZ);
 
+  Start = ArmReadCntPct();
   Status = val_pe_create_info_table(PeInfoTable);
+  recordInfoTableTime("PE        ", Start);
 
   return Status;
 }
@@ -505,10 +593,13 @@ createGicInfoTable (
 {
   UINT32 Status;
   UINT64 *GicInfoTable;
+  UINT64 Start;
 
   GicInfoTable = val_aligned_alloc(SIZE_4K, GIC_INFO_TBL_SZ);
 
+  Start = ArmReadCntPct();
   Status = val_gic_create_info_table(GicInfoTable);
+  recordInfoTableTime("GIC       ", Start);
 
   return Status;
 }
@@ -518,10 +609,13 @@ createTimerInfoTable(
 )
 {
   UINT64 *TimerInfoTable;
+  UINT64 Start;
 
   TimerInfoTable = val_aligned_alloc(SIZE_4K, TIMER_INFO_TBL_SZ);
 
+  Start = ArmReadCntPct();
   val_timer_create_info_table(TimerInfoTable);
+  recordInfoTableTime("Timer     ", Start);
 }
 
 VOID
@@ -529,10 +623,13 @@ createWatchdogInfoTable(
 )
 {
   UINT64 *WdInfoTable;
+  UINT64 Start;
 
   WdInfoTable = val_aligned_alloc(SIZE_4K, WD_INFO_TBL_SZ);
 
+  Start = ArmReadCntPct();
   val_wd_create_info_table(WdInfoTable);
+  recordInfoTableTime("Watchdog  ", Start);
 }
 
 
@@ -542,14 +639,19 @@ createPcieVirtInfoTable(
 {
   UINT64 *PcieInfoTable;
   UINT64 *IoVirtInfoTable;
+  UINT64 Start;
 
   PcieInfoTable   = val_aligned_alloc(SIZE_4K, PCIE_INFO_TBL_SZ);
 
+  Start = ArmReadCntPct();
   val_pcie_create_info_table(PcieInfoTable);
+  recordInfoTableTime("PCIe      ", Start);
 
   IoVirtInfoTable = val_aligned_alloc(SIZE_4K, IOVIRT_INFO_TBL_SZ);
 
+  Start = ArmReadCntPct();
   val_iovirt_create_info_table(IoVirtInfoTable);
+  recordInfoTableTime("IOVIRT    ", Start);
 }
 
 VOID
@@ -558,14 +660,19 @@ createPeripheralInfoTable(
 {
   UINT64 *PeripheralInfoTable;
   UINT64 *MemoryInfoTable;
+  UINT64 Start;
 
   PeripheralInfoTable = val_aligned_alloc(SIZE_4K, PERIPHERAL_INFO_TBL_SZ);
 
+  Start = ArmReadCntPct();
   val_peripheral_create_info_table(PeripheralInfoTable);
+  recordInfoTableTime("Peripheral", Start);
 
   MemoryInfoTable = val_aligned_alloc(SIZE_4K, MEM_INFO_TBL_SZ);
 
+  Start = ArmReadCntPct();
   val_memory_create_info_table(MemoryInfoTable);
+  recordInfoTableTime("Memory    ", Start);
 }
 
 VOID
@@ -573,10 +680,13 @@ createSmbiosInfoTable(
 )
 {
   UINT64 *SmbiosInfoTable;
+  UINT64 Start;
 
   SmbiosInfoTable = val_aligned_alloc(SIZE_4K, SMBIOS_INFO_TBL_SZ);
 
+  Start = ArmReadCntPct();
   val_smbios_create_info_table(SmbiosInfoTable);
+  recordInfoTableTime("SMBIOS    ", Start);
 }
 
 VOID
@@ -599,6 +709,9 @@ execute_tests()
   VOID               *branch_label;
   UINT32             Status;
 
+  if (g_log_buffered)
+    val_log_set_mode(PAL_LOG_BUFFERED);
+
   val_print(ACS_PRINT_TEST, "\n\n BSA Architecture Compliance Suite", 0);
   val_print(ACS_PRINT_TEST, "\n          Version %d.", BSA_ACS_MAJOR_VER);
   val_print(ACS_PRINT_TEST, "%d.", BSA_ACS_MINOR_VER);
@@ -617,15 +730,19 @@ execute_tests()
 
   Status = createPeInfoTable();
   if (Status) {
-      if (g_acs_log_file_handle)
+      if (g_acs_log_file_handle) {
+        val_log_flush();
         ShellCloseFile(&g_acs_log_file_handle);
+      }
      return Status;
   }
 
   Status = createGicInfoTable();
   if (Status) {
-      if (g_acs_log_file_handle)
+      if (g_acs_log_file_handle) {
+        val_log_flush();
         ShellCloseFile(&g_acs_log_file_handle);
+      }
       return Status;
   }
 
@@ -634,9 +751,19 @@ execute_tests()
   createPcieVirtInfoTable();
   createPeripheralInfoTable();
   createSmbiosInfoTable();
+  printInfoTableTime();
 
   val_allocate_shared_mem();
 
+  if (g_pe_pool)
+    val_pe_pool_enable();
+
+  if (g_shm_stress)
+    val_shared_mem_stress(val_pe_get_num());
+
+  if (g_log_bench && g_acs_log_file_handle)
+    val_log_benchmark(VAL_LOG_BENCHMARK_LINES);
+
   FlushImage();
   val_bsa_execute_tests(g_sw_view);
 
@@ -662,6 +789,7 @@ print_test_status:
   val_print(ACS_PRINT_ERR, "\n      *** BSA tests complete. Reset the system. ***\n\n", 0);
 
   if (g_acs_log_file_handle) {
+    val_log_flush();
     ShellCloseFile(&g_acs_log_file_handle);
   }
 
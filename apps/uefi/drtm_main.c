@@ -340,6 +340,7 @@ execute_tests()
   val_print(ACS_PRINT_ERR, "\n      *** DRTM tests complete. *** \n\n", 0);
 
   if (g_acs_log_file_handle) {
+    val_log_flush();
     ShellCloseFile(&g_acs_log_file_handle);
   }
 
@@ -622,15 +622,19 @@ execute_tests()
 
   Status = createPeInfoTable();
   if (Status) {
-      if (g_acs_log_file_handle)
+      if (g_acs_log_file_handle) {
+        val_log_flush();
         ShellCloseFile(&g_acs_log_file_handle);
+      }
      return Status;
   }
 
   Status = createGicInfoTable();
   if (Status) {
-      if (g_acs_log_file_handle)
+      if (g_acs_log_file_handle) {
+        val_log_flush();
         ShellCloseFile(&g_acs_log_file_handle);
+      }
       return Status;
   }
 
@@ -673,6 +677,7 @@ print_test_status:
   mem_model_execute_tests(myImageHandle, mySystemTable);
 
   if (g_acs_log_file_handle) {
+    val_log_flush();
     ShellCloseFile(&g_acs_log_file_handle);
   }
 
@@ -445,6 +445,7 @@ print_test_status:
     val_print(ACS_PRINT_ERR, "     --------------------------------------------------------- \n", 0);
 
     if (g_acs_log_file_handle) {
+        val_log_flush();
         ShellCloseFile(&g_acs_log_file_handle);
     }
 
@@ -499,15 +499,19 @@ execute_tests()
 
   Status = createPeInfoTable();
   if (Status) {
-      if (g_acs_log_file_handle)
+      if (g_acs_log_file_handle) {
+        val_log_flush();
         ShellCloseFile(&g_acs_log_file_handle);
+      }
      return Status;
   }
 
   Status = createGicInfoTable();
   if (Status) {
-      if (g_acs_log_file_handle)
+      if (g_acs_log_file_handle) {
+        val_log_flush();
         ShellCloseFile(&g_acs_log_file_handle);
+      }
       return Status;
   }
 
@@ -545,6 +549,7 @@ print_test_status:
 
 
   if (g_acs_log_file_handle) {
+    val_log_flush();
     ShellCloseFile(&g_acs_log_file_handle);
   }
 
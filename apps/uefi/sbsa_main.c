@@ -58,6 +58,15 @@ SHELL_FILE_HANDLE g_acs_log_file_handle;
    of EL1 phy and virt timer, Below command line option is added only for debug
    purpose to complete SBSA run on these systems */
 UINT32  g_el1physkip = FALSE;
+/* Keep secondary PEs parked between multi-PE payloads instead of
+   switching them off, see val_pe_pool_enable */
+UINT32  g_pe_pool = FALSE;
+/* Run the shared status record stress after setup, see val_shared_mem_stress */
+UINT32  g_shm_stress = FALSE;
+/* Stage log file output and write it in batches, see val_log_set_mode */
+UINT32  g_log_buffered = FALSE;
+/* Time the log sink modes after setup, see val_log_benchmark */
+UINT32  g_log_bench = FALSE;
 
 #define SBSA_LEVEL_PRINT_FORMAT(level, only) ((level > SBSA_MAX_LEVEL_SUPPORTED) ? \
     ((only) != 0 ? "\n Starting tests for only level FR " : "\n Starting tests for level FR ") : \
@@ -319,6 +328,10 @@ HelpMsg (
          "        1 - PPTT PE-side cache,  2 - HMAT mem-side cache\n"
          "         defaults to 0, if not set depicting SLC type unknown\n"
          "-el1physkip Skips EL1 register checks\n"
+         "-pe_pool Keep secondary PEs parked between multi-PE tests\n"
+         "-shm_stress Stress the per-PE shared status records from all PEs\n"
+         "-log_buffer Write the log file in batches instead of once per print\n"
+         "-log_bench Time the log sink modes, requires -f\n"
          "-skip-dp-nic-ms Skip PCIe tests for DisplayPort, Network, and Mass Storage devices\n"
   );
 }
@@ -343,6 +356,10 @@ STATIC CONST SHELL_PARAM_ITEM ParamList[] = {
   {L"-timeout" , TypeValue}, // -timeout # Set timeout multiple for wakeup tests
   {L"-slc"  , TypeValue},    // -slc  # system last level cache type
   {L"-el1physkip", TypeFlag}, // -el1physkip # Skips EL1 register checks
+  {L"-pe_pool", TypeFlag},   // -pe_pool # Park secondary PEs between tests
+  {L"-shm_stress", TypeFlag}, // -shm_stress # Stress per-PE shared status records
+  {L"-log_buffer", TypeFlag}, // -log_buffer # Batch log file writes
+  {L"-log_bench", TypeFlag},  // -log_bench # Time the log sink modes
   {NULL     , TypeMax}
   };
 
@@ -580,6 +597,22 @@ command_init ()
   if (ShellCommandLineGetFlag (ParamPackage, L"-el1physkip")) {
     g_el1physkip = TRUE;
   }
+
+  if (ShellCommandLineGetFlag (ParamPackage, L"-pe_pool")) {
+    g_pe_pool = TRUE;
+  }
+
+  if (ShellCommandLineGetFlag (ParamPackage, L"-shm_stress")) {
+    g_shm_stress = TRUE;
+  }
+
+  if (ShellCommandLineGetFlag (ParamPackage, L"-log_buffer")) {
+    g_log_buffered = TRUE;
+  }
+
+  if (ShellCommandLineGetFlag (ParamPackage, L"-log_bench")) {
+    g_log_bench = TRUE;
+  }
   //
   // Initialize global counters
   //
@@ -596,6 +629,9 @@ execute_tests()
   VOID               *branch_label;
   UINT32             Status;
 
+  if (g_log_buffered)
+    val_log_set_mode(PAL_LOG_BUFFERED);
+
   val_print(ACS_PRINT_ERR, "\n\n SBSA Architecture Compliance Suite\n", 0);
   val_print(ACS_PRINT_ERR, "    Version %d.", SBSA_ACS_MAJOR_VER);
   val_print(ACS_PRINT_ERR, "%d.", SBSA_ACS_MINOR_VER);
@@ -614,15 +650,19 @@ execute_tests()
 
   Status = createPeInfoTable();
   if (Status) {
-      if (g_acs_log_file_handle)
+      if (g_acs_log_file_handle) {
+        val_log_flush();
         ShellCloseFile(&g_acs_log_file_handle);
+      }
      return Status;
   }
 
   Status = createGicInfoTable();
   if (Status) {
-      if (g_acs_log_file_handle)
+      if (g_acs_log_file_handle) {
+        val_log_flush();
         ShellCloseFile(&g_acs_log_file_handle);
+      }
       return Status;
   }
 
@@ -642,6 +682,15 @@ execute_tests()
 
   val_allocate_shared_mem();
 
+  if (g_pe_pool)
+    val_pe_pool_enable();
+
+  if (g_shm_stress)
+    val_shared_mem_stress(val_pe_get_num());
+
+  if (g_log_bench && g_acs_log_file_handle)
+    val_log_benchmark(VAL_LOG_BENCHMARK_LINES);
+
   FlushImage();
   val_sbsa_execute_tests(g_sbsa_level);
 
@@ -663,6 +712,7 @@ print_test_status:
   val_print(ACS_PRINT_ERR, "\n      *** SBSA tests complete. Reset the system. ***\n\n", 0);
 
   if (g_acs_log_file_handle) {
+    val_log_flush();
     ShellCloseFile(&g_acs_log_file_handle);
   }
 
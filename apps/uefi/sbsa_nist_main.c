@@ -25,6 +25,7 @@
 #include "val/include/acs_pe.h"
 #include "val/include/acs_val.h"
 #include "val/include/acs_memory.h"
+#include "val/include/acs_nist.h"
 
 #include "acs.h"
 
@@ -309,6 +310,8 @@ HelpMsg (
          "        To skip a module, use Module ID as mentioned in user guide\n"
          "        To skip a particular test within a module, use the exact testcase number\n"
          "-nist   Enable the NIST Statistical test suite\n"
+         "-nist_streams  Number of 100000 bit streams to run through NIST STS\n"
+         "        Defaults to 10, 1000 - max value\n"
          "-t      If Test ID(s) set, will only run the specified test, all others will be skipped.\n"
          "-m      If Module ID(s) set, will only run the specified module, all others will be skipped.\n"
          "-no_crypto_ext  Pass this flag if cryptography extension not supported due to export restrictions\n"
@@ -335,6 +338,7 @@ STATIC CONST SHELL_PARAM_ITEM ParamList[] = {
   {L"-help" , TypeFlag},     // -help # help : info about commands
   {L"-h"    , TypeFlag},     // -h    # help : info about commands
   {L"-nist" , TypeFlag},     // -nist # Binary Flag to enable the execution of NIST STS
+  {L"-nist_streams", TypeValue}, // -nist_streams # Number of bitstreams for NIST STS
   {L"-mmio" , TypeValue},    // -mmio # Enable pal_mmio prints
   {L"-t"    , TypeValue},    // -t    # Test to be run
   {L"-m"    , TypeValue},    // -m    # Module to be run
@@ -585,6 +589,15 @@ command_init ()
     g_execute_nist = FALSE;
   }
 
+  CmdLineArg  = ShellCommandLineGetValue (ParamPackage, L"-nist_streams");
+  if (CmdLineArg != NULL) {
+    nist_num_streams = StrDecimalToUintn(CmdLineArg);
+    if ((nist_num_streams == 0) || (nist_num_streams > NIST_MAX_STREAMS)) {
+      Print(L"Invalid NIST stream count, using %d.\n", NIST_DEFAULT_STREAMS);
+      nist_num_streams = NIST_DEFAULT_STREAMS;
+    }
+  }
+
   if (ShellCommandLineGetFlag (ParamPackage, L"-el1physkip")) {
     g_el1physkip = TRUE;
   }
@@ -622,15 +635,19 @@ execute_tests()
 
   Status = createPeInfoTable();
   if (Status) {
-      if (g_acs_log_file_handle)
+      if (g_acs_log_file_handle) {
+        val_log_flush();
         ShellCloseFile(&g_acs_log_file_handle);
+      }
      return Status;
   }
 
   Status = createGicInfoTable();
   if (Status) {
-      if (g_acs_log_file_handle)
+      if (g_acs_log_file_handle) {
+        val_log_flush();
         ShellCloseFile(&g_acs_log_file_handle);
+      }
       return Status;
   }
 
@@ -676,6 +693,7 @@ print_test_status:
   val_print(ACS_PRINT_ERR, "\n      *** SBSA tests complete. Reset the system. ***\n\n", 0);
 
   if (g_acs_log_file_handle) {
+    val_log_flush();
     ShellCloseFile(&g_acs_log_file_handle);
   }
 
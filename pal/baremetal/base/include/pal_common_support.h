@@ -62,6 +62,17 @@ void *pal_aligned_alloc( uint32_t alignment, uint32_t size );
 
 void pal_uart_print(int log, const char *fmt, ...);
 void *mem_alloc(size_t alignment, size_t size);
+void pal_heap_init(uint64_t base, uint64_t size);
+void *pal_heap_alloc(size_t alignment, size_t size);
+void pal_heap_free(void *ptr);
+void pal_heap_report(void);
+
+/* Buffer size and passes timed by pal_mem_benchmark */
+#define PAL_MEM_BENCH_SIZE        0x100000
+#define PAL_MEM_BENCH_ITERATIONS  16
+
+void *pal_memcpy_nontemporal(void *DestinationBuffer, const void *SourceBuffer, uint32_t Length);
+void pal_mem_benchmark(void);
 #define print(verbose, string, ...)  if(verbose >= g_print_level) \
                                                    pal_uart_print(verbose, string, ##__VA_ARGS__)
 
@@ -1056,6 +1067,13 @@ typedef struct {
   uint64_t                         cmd_complete_update_preserve;
                                                             /* command complete update preserve */
   uint64_t                         cmd_complete_update_set; /* command complete update set mask */
+  uint32_t                         nominal_latency_usec;    /* expected command latency */
+  uint32_t                         platform_intr;           /* platform interrupt GSIV, 0 if none */
+  uint32_t                         platform_intr_flags;     /* platform interrupt flags */
+  GENERIC_ADDRESS_STRUCTURE        platform_intr_ack_reg;   /* platform interrupt ack register */
+  uint64_t                         platform_intr_ack_preserve;
+                                                            /* platform interrupt ack preserve */
+  uint64_t                         platform_intr_ack_set;   /* platform interrupt ack set mask */
 } PCC_SUBSPACE_TYPE_3;
 
 typedef union {
@@ -30,6 +30,7 @@
 #define TYPE01_RIDR        0x8
 
 #define PCIE_HEADER_TYPE(header_value) ((header_value >> 16) & 0x3)
+#define PCIE_HEADER_MFD(header_value)  ((header_value >> 23) & 0x1)
 #define BUS_NUM_REG_CFG(sub_bus, sec_bus, pri_bus) (sub_bus << 16 | sec_bus << 8 | bus)
 
 #define DEVICE_ID_OFFSET   16
@@ -0,0 +1,364 @@
+/** @file
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "pal_common_support.h"
+
+/* Baremetal heap shared by all targets. The heap region is managed in pages:
+   large or page-aligned requests get a run of pages from an address ordered
+   free list, and freed runs are coalesced with their neighbours. Small
+   requests are served from per size-class free lists refilled with slabs of
+   pages. A page map at the start of the region records, for every page, the
+   length of the block starting there or the size class of its slab. */
+
+#define HEAP_PAGE_SHIFT       12
+#define HEAP_PAGE_SIZE        (1ULL << HEAP_PAGE_SHIFT)
+
+#define HEAP_MIN_CLASS_SHIFT  5     /* 32 byte slots */
+#define HEAP_MAX_CLASS_SHIFT  11    /* 2KB slots */
+#define HEAP_NUM_CLASSES      (HEAP_MAX_CLASS_SHIFT - HEAP_MIN_CLASS_SHIFT + 1)
+#define HEAP_SLAB_PAGES       16    /* Pages carved into slots per refill */
+
+/* Page map entry: 0 for free pages and block interiors, the page count at the
+   head of a block, or HEAP_PAGE_SLAB | class for every page of a slab */
+#define HEAP_PAGE_SLAB        0x80000000
+
+typedef struct heap_run {
+  struct heap_run *next;
+  uint64_t         pages;
+} HEAP_RUN;
+
+typedef struct heap_slot {
+  struct heap_slot *next;
+} HEAP_SLOT;
+
+typedef struct {
+  uint64_t   base;             /* First allocatable page */
+  uint64_t   num_pages;
+  uint32_t  *page_map;
+  HEAP_RUN  *free_runs;        /* Address ordered, coalesced */
+  HEAP_SLOT *slots[HEAP_NUM_CLASSES];
+  uint64_t   free_pages;
+  uint64_t   used_pages_hwm;
+  uint64_t   used_bytes;       /* Bytes handed out, rounded to slot/page size */
+  uint64_t   used_bytes_hwm;
+  uint32_t   alloc_fail;
+} HEAP_STATE;
+
+static HEAP_STATE g_heap;
+
+static uint64_t
+heap_page_index(uint64_t addr)
+{
+  return (addr - g_heap.base) >> HEAP_PAGE_SHIFT;
+}
+
+static void
+heap_account(int64_t bytes)
+{
+  uint64_t used_pages;
+
+  g_heap.used_bytes += bytes;
+  if (g_heap.used_bytes > g_heap.used_bytes_hwm)
+    g_heap.used_bytes_hwm = g_heap.used_bytes;
+
+  used_pages = g_heap.num_pages - g_heap.free_pages;
+  if (used_pages > g_heap.used_pages_hwm)
+    g_heap.used_pages_hwm = used_pages;
+}
+
+/**
+  @brief  Take a run of pages from the free list, first fit.
+
+  @param  pages      Number of pages
+  @param  alignment  Address alignment in bytes, a power of 2 >= page size
+
+  @return Base address of the run, or 0 if no free run is large enough
+**/
+static uint64_t
+heap_page_alloc(uint64_t pages, uint64_t alignment)
+{
+  HEAP_RUN *run, *prev = NULL, *tail;
+  uint64_t run_addr, addr, lead, rest;
+
+  for (run = g_heap.free_runs; run != NULL; prev = run, run = run->next) {
+    run_addr = (uint64_t)run;
+    addr = (run_addr + alignment - 1) & ~(alignment - 1);
+    lead = (addr - run_addr) >> HEAP_PAGE_SHIFT;
+    if (lead + pages > run->pages)
+      continue;
+
+    rest = run->pages - lead - pages;
+    tail = (HEAP_RUN *)(addr + (pages << HEAP_PAGE_SHIFT));
+
+    /* Keep the unaligned lead in place and link the tail after it */
+    if (rest) {
+      tail->pages = rest;
+      tail->next = run->next;
+    } else
+      tail = run->next;
+
+    if (lead) {
+      run->pages = lead;
+      run->next = tail;
+    } else if (prev)
+      prev->next = tail;
+    else
+      g_heap.free_runs = tail;
+
+    g_heap.page_map[heap_page_index(addr)] = (uint32_t)pages;
+    g_heap.free_pages -= pages;
+    return addr;
+  }
+
+  return 0;
+}
+
+/**
+  @brief  Return a run of pages to the free list, merging it with the runs
+          immediately before and after it.
+
+  @param  addr   Base address of the run
+  @param  pages  Number of pages
+
+  @return None
+**/
+static void
+heap_page_free(uint64_t addr, uint64_t pages)
+{
+  HEAP_RUN *run = (HEAP_RUN *)addr;
+  HEAP_RUN *prev = NULL, *next = g_heap.free_runs;
+
+  while ((next != NULL) && ((uint64_t)next < addr)) {
+    prev = next;
+    next = next->next;
+  }
+
+  run->pages = pages;
+  run->next = next;
+
+  if ((next != NULL) && (addr + (pages << HEAP_PAGE_SHIFT) == (uint64_t)next)) {
+    run->pages += next->pages;
+    run->next = next->next;
+  }
+
+  if ((prev != NULL) && ((uint64_t)prev + (prev->pages << HEAP_PAGE_SHIFT) == addr)) {
+    prev->pages += run->pages;
+    prev->next = run->next;
+  } else if (prev != NULL)
+    prev->next = run;
+  else
+    g_heap.free_runs = run;
+
+  g_heap.free_pages += pages;
+}
+
+/**
+  @brief  Carve a slab of pages into slots of the given size class.
+
+  @param  cls  Size class index
+
+  @return 0 on success, 1 if the heap is out of pages
+**/
+static uint32_t
+heap_slab_refill(uint32_t cls)
+{
+  uint64_t addr, slot_size, i, idx;
+  HEAP_SLOT *slot;
+
+  addr = heap_page_alloc(HEAP_SLAB_PAGES, HEAP_PAGE_SIZE);
+  if (addr == 0)
+    return 1;
+
+  idx = heap_page_index(addr);
+  for (i = 0; i < HEAP_SLAB_PAGES; i++)
+    g_heap.page_map[idx + i] = HEAP_PAGE_SLAB | cls;
+
+  slot_size = 1ULL << (cls + HEAP_MIN_CLASS_SHIFT);
+  for (i = (HEAP_SLAB_PAGES << HEAP_PAGE_SHIFT); i >= slot_size; i -= slot_size) {
+    slot = (HEAP_SLOT *)(addr + i - slot_size);
+    slot->next = g_heap.slots[cls];
+    g_heap.slots[cls] = slot;
+  }
+
+  heap_account(0);
+  return 0;
+}
+
+/**
+  @brief  Initialise the heap over the given memory region. The page map is
+          placed at the start of the region.
+
+  @param  base  Base address of the heap region
+  @param  size  Size of the heap region in bytes
+
+  @return None
+**/
+void
+pal_heap_init(uint64_t base, uint64_t size)
+{
+  uint64_t start, end, total, map_pages;
+
+  pal_mem_set(&g_heap, sizeof(g_heap), 0);
+
+  start = (base + HEAP_PAGE_SIZE - 1) & ~(HEAP_PAGE_SIZE - 1);
+  end = (base + size) & ~(HEAP_PAGE_SIZE - 1);
+  if (end <= start)
+    return;
+
+  total = (end - start) >> HEAP_PAGE_SHIFT;
+  map_pages = ((total * sizeof(uint32_t)) + HEAP_PAGE_SIZE - 1) >> HEAP_PAGE_SHIFT;
+  if (map_pages >= total)
+    return;
+
+  g_heap.page_map = (uint32_t *)start;
+  g_heap.base = start + (map_pages << HEAP_PAGE_SHIFT);
+  g_heap.num_pages = total - map_pages;
+  pal_mem_set(g_heap.page_map, (uint32_t)(g_heap.num_pages * sizeof(uint32_t)), 0);
+
+  g_heap.free_runs = (HEAP_RUN *)g_heap.base;
+  g_heap.free_runs->next = NULL;
+  g_heap.free_runs->pages = g_heap.num_pages;
+  g_heap.free_pages = g_heap.num_pages;
+}
+
+/**
+  @brief  Allocate memory from the heap.
+
+  @param  alignment  Alignment of the returned address, a power of 2
+  @param  size       Size in bytes
+
+  @return Base address of the allocation, or NULL on failure
+**/
+void *
+pal_heap_alloc(size_t alignment, size_t size)
+{
+  uint64_t pages, addr;
+  uint32_t shift;
+  HEAP_SLOT *slot;
+
+  if ((size == 0) || (alignment == 0) || (alignment & (alignment - 1)))
+    return NULL;
+
+  /* Slots are naturally aligned to their size, so the class covers alignment too */
+  if ((size <= (1ULL << HEAP_MAX_CLASS_SHIFT)) && (alignment <= (1ULL << HEAP_MAX_CLASS_SHIFT))) {
+    shift = HEAP_MIN_CLASS_SHIFT;
+    while (((1ULL << shift) < size) || ((1ULL << shift) < alignment))
+      shift++;
+
+    if ((g_heap.slots[shift - HEAP_MIN_CLASS_SHIFT] == NULL) &&
+        heap_slab_refill(shift - HEAP_MIN_CLASS_SHIFT)) {
+      g_heap.alloc_fail++;
+      return NULL;
+    }
+
+    slot = g_heap.slots[shift - HEAP_MIN_CLASS_SHIFT];
+    g_heap.slots[shift - HEAP_MIN_CLASS_SHIFT] = slot->next;
+    heap_account(1LL << shift);
+    return (void *)slot;
+  }
+
+  if (alignment < HEAP_PAGE_SIZE)
+    alignment = HEAP_PAGE_SIZE;
+
+  pages = (size + HEAP_PAGE_SIZE - 1) >> HEAP_PAGE_SHIFT;
+  addr = heap_page_alloc(pages, alignment);
+  if (addr == 0) {
+    g_heap.alloc_fail++;
+    return NULL;
+  }
+
+  heap_account(pages << HEAP_PAGE_SHIFT);
+  return (void *)addr;
+}
+
+/**
+  @brief  Return memory allocated by pal_heap_alloc to the heap. Pointers
+          outside the heap, or not at the start of an allocation, are ignored.
+
+  @param  ptr  Address returned by pal_heap_alloc
+
+  @return None
+**/
+void
+pal_heap_free(void *ptr)
+{
+  uint64_t addr = (uint64_t)ptr;
+  uint64_t slot_size;
+  uint32_t tag, cls;
+  HEAP_SLOT *slot;
+
+  if ((addr < g_heap.base) ||
+      (addr >= g_heap.base + (g_heap.num_pages << HEAP_PAGE_SHIFT)))
+    return;
+
+  tag = g_heap.page_map[heap_page_index(addr)];
+
+  if (tag & HEAP_PAGE_SLAB) {
+    cls = tag & ~HEAP_PAGE_SLAB;
+    slot_size = 1ULL << (cls + HEAP_MIN_CLASS_SHIFT);
+    if (addr & (slot_size - 1))
+      return;
+
+    slot = (HEAP_SLOT *)addr;
+    slot->next = g_heap.slots[cls];
+    g_heap.slots[cls] = slot;
+    heap_account(-(int64_t)slot_size);
+    return;
+  }
+
+  if ((tag == 0) || (addr & (HEAP_PAGE_SIZE - 1)))
+    return;
+
+  g_heap.page_map[heap_page_index(addr)] = 0;
+  heap_page_free(addr, tag);
+  heap_account(-(int64_t)((uint64_t)tag << HEAP_PAGE_SHIFT));
+}
+
+/**
+  @brief  Print heap usage: high-water marks, what is still allocated and how
+          fragmented the free pages are.
+
+  @param  None
+
+  @return None
+**/
+void
+pal_heap_report(void)
+{
+  HEAP_RUN *run;
+  uint64_t largest = 0, runs = 0;
+
+  for (run = g_heap.free_runs; run != NULL; run = run->next) {
+    runs++;
+    if (run->pages > largest)
+      largest = run->pages;
+  }
+
+  print(ACS_PRINT_DEBUG, "\n Heap size              : %ld KB",
+        (g_heap.num_pages << HEAP_PAGE_SHIFT) >> 10);
+  print(ACS_PRINT_DEBUG, "\n Heap high-water mark   : %ld KB",
+        (g_heap.used_pages_hwm << HEAP_PAGE_SHIFT) >> 10);
+  print(ACS_PRINT_DEBUG, "\n Heap peak allocated    : %ld KB", g_heap.used_bytes_hwm >> 10);
+  print(ACS_PRINT_DEBUG, "\n Heap still allocated   : %ld KB", g_heap.used_bytes >> 10);
+  print(ACS_PRINT_DEBUG, "\n Heap free runs         : %ld", runs);
+  if (g_heap.free_pages)
+    print(ACS_PRINT_DEBUG, "\n Heap fragmentation     : %ld%%",
+          100 - ((largest * 100) / g_heap.free_pages));
+  if (g_heap.alloc_fail)
+    print(ACS_PRINT_WARN, "\n Heap allocation failures : %d", g_heap.alloc_fail);
+  print(ACS_PRINT_DEBUG, "\n", 0);
+}
@@ -309,7 +309,9 @@ pal_mem_calloc(uint32_t num, uint32_t Size)
 
 
 /**
-  @brief  Allocate memory which is to be used to share data across PEs
+  @brief  Allocate memory which is to be used to share data across PEs.
+          The region is page aligned so that per-PE entries padded to the
+          cache writeback granule never share a cache line.
 
   @param  num_pe      - Number of PEs in the system
   @param  sizeofentry - Size of memory region allocated to each PE
@@ -320,10 +322,39 @@ void
 pal_mem_allocate_shared(uint32_t num_pe, uint32_t sizeofentry)
 {
    gSharedMemory = 0;
-   gSharedMemory = pal_mem_alloc(num_pe * sizeofentry);
+   gSharedMemory = pal_aligned_alloc(MEM_ALIGN_4K, num_pe * sizeofentry);
    pal_pe_data_cache_ops_by_va((uint64_t)&gSharedMemory, CLEAN_AND_INVALIDATE);
 }
 
+/**
+  @brief  Write staged log output to the log file. Baremetal output goes
+          straight to the UART, so there is nothing to flush.
+
+  @param  None
+
+  @return None
+**/
+void
+pal_log_flush(void)
+{
+  return;
+}
+
+/**
+  @brief  Select how print output reaches the log file. Baremetal has no
+          log file, so the mode is ignored.
+
+  @param  mode  One of PAL_LOG_CONSOLE, PAL_LOG_BUFFERED, PAL_LOG_UNBUFFERED
+
+  @return None
+**/
+void
+pal_log_set_mode(uint32_t mode)
+{
+  (void)mode;
+  return;
+}
+
 /**
   @brief   Checks if System information is passed using Baremetal (BM)
            This api is also used to check if GIC/Interrupt Init ACS Code
@@ -339,6 +370,51 @@ pal_target_is_bm()
   return 1;
 }
 
+/* Word-wide memory helpers. Buffers that share 8-byte alignment are moved in
+   64-byte blocks by the AArch64 helpers in PalMemOps.S; the unaligned head
+   and the tail are handled a byte at a time. */
+#define PAL_MEM_BLOCK        64
+#define PAL_MEM_BULK_MIN     (2 * PAL_MEM_BLOCK)
+
+void PalMemCopyBlocks(void *dst, const void *src, uint64_t len);
+void PalMemCopyBlocksNT(void *dst, const void *src, uint64_t len);
+void PalMemSetBlocks(void *dst, uint64_t pattern, uint64_t len);
+void PalMemZeroBlocks(void *dst, uint64_t len, uint64_t block);
+uint64_t PalMemZvaSize(void);
+uint64_t PalReadCntPct(void);
+uint64_t PalReadCntFrq(void);
+
+static void *
+pal_memcpy_common(void *DestinationBuffer, const void *SourceBuffer, uint32_t Length,
+                  uint32_t NonTemporal)
+{
+    const uint8_t *s = (const uint8_t *)SourceBuffer;
+    uint8_t *d = (uint8_t *)DestinationBuffer;
+    uint32_t bulk;
+
+    if ((Length >= PAL_MEM_BULK_MIN) && ((((uint64_t)d ^ (uint64_t)s) & 0x7) == 0)) {
+        while ((uint64_t)d & 0x7) {
+            *d++ = *s++;
+            Length--;
+        }
+
+        bulk = Length & ~(PAL_MEM_BLOCK - 1);
+        if (NonTemporal)
+            PalMemCopyBlocksNT(d, s, bulk);
+        else
+            PalMemCopyBlocks(d, s, bulk);
+
+        d += bulk;
+        s += bulk;
+        Length -= bulk;
+    }
+
+    while (Length--)
+        *d++ = *s++;
+
+    return DestinationBuffer;
+}
+
 /**
   Copies a source buffer to a destination buffer, and returns the destination buffer.
 
@@ -352,17 +428,24 @@ pal_target_is_bm()
 void *
 pal_memcpy(void *DestinationBuffer, const void *SourceBuffer, uint32_t Length)
 {
+    return pal_memcpy_common(DestinationBuffer, SourceBuffer, Length, 0);
+}
 
-    uint32_t i;
-    const char *s = (char *)SourceBuffer;
-    char *d = (char *) DestinationBuffer;
+/**
+  Copies a source buffer to a destination buffer with non-temporal loads and
+  stores, for large copies that should not displace the cached working set.
 
-    for(i = 0; i < Length; i++)
-    {
-        d[i] = s[i];
-    }
+  @param  DestinationBuffer   The pointer to the destination buffer of the memory copy.
+  @param  SourceBuffer        The pointer to the source buffer of the memory copy.
+  @param  Length              The number of bytes to copy from SourceBuffer to DestinationBuffer.
+
+  @return DestinationBuffer.
 
-    return d;
+**/
+void *
+pal_memcpy_nontemporal(void *DestinationBuffer, const void *SourceBuffer, uint32_t Length)
+{
+    return pal_memcpy_common(DestinationBuffer, SourceBuffer, Length, 1);
 }
 
 uint32_t pal_strncmp(const char8_t *str1, const char8_t *str2, uint32_t len)
@@ -408,28 +491,139 @@ void *pal_strncpy(void *DestinationStr, const void *SourceStr, uint32_t Length)
 int32_t
 pal_mem_compare(void *Src, void *Dest, uint32_t Len)
 {
-    if (Len != 0) {
-    register const unsigned char *p1 = Dest, *p2 = Src;
+    const uint8_t *p1 = Dest, *p2 = Src;
+
+    /* Skip equal words, the byte loop below finds the first difference */
+    if ((((uint64_t)p1 ^ (uint64_t)p2) & 0x7) == 0) {
+        while (Len && ((uint64_t)p1 & 0x7)) {
+            if (*p1 != *p2)
+                return (*p1 - *p2);
+            p1++;
+            p2++;
+            Len--;
+        }
 
-    do {
-      if (*p1++ != *p2++)
-        return (*--p1 - *--p2);
-    } while (--Len != 0);
-  }
-  return (0);
+        while ((Len >= 8) && (*(const uint64_t *)p1 == *(const uint64_t *)p2)) {
+            p1 += 8;
+            p2 += 8;
+            Len -= 8;
+        }
+    }
+
+    while (Len--) {
+        if (*p1 != *p2)
+            return (*p1 - *p2);
+        p1++;
+        p2++;
+    }
+
+    return (0);
 }
 
 void
 pal_mem_set(void *buf, uint32_t size, uint8_t value)
 {
-    unsigned char *ptr = buf;
+    uint8_t *ptr = buf;
+    uint64_t zva, bulk;
+
+    if (size >= PAL_MEM_BULK_MIN) {
+        while ((uint64_t)ptr & 0x7) {
+            *ptr++ = value;
+            size--;
+        }
+
+        /* Zero whole ZVA blocks with DC ZVA when it is usable */
+        zva = (value == 0) ? PalMemZvaSize() : 0;
+        if (zva && (size >= 2 * zva)) {
+            while ((uint64_t)ptr & (zva - 1)) {
+                *(uint64_t *)ptr = 0;
+                ptr += 8;
+                size -= 8;
+            }
+            bulk = size & ~(zva - 1);
+            PalMemZeroBlocks(ptr, bulk, zva);
+            ptr += bulk;
+            size -= bulk;
+        }
+
+        bulk = size & ~(PAL_MEM_BLOCK - 1);
+        if (bulk) {
+            PalMemSetBlocks(ptr, value * 0x0101010101010101ULL, bulk);
+            ptr += bulk;
+            size -= bulk;
+        }
+    }
 
     while (size--)
-    {
-        *ptr++ = (unsigned char)value;
+        *ptr++ = value;
+}
+
+/**
+  @brief  Time pal_memcpy, pal_memcpy_nontemporal, pal_mem_set and
+          pal_mem_compare over two buffers and print the bandwidth of each.
+          Run only when PLATFORM_OVERRIDE_MEM_BENCHMARK is set.
+
+  @param  None
+
+  @return None
+**/
+void
+pal_mem_benchmark(void)
+{
+    const char *name[] = {"memcpy", "memcpy non-temporal", "memset", "memset zero",
+                          "memcmp"};
+    uint32_t num_tests = sizeof(name) / sizeof(name[0]);
+    uint32_t size = PAL_MEM_BENCH_SIZE;
+    uint64_t start, ticks, freq, rate;
+    uint8_t *src, *dst;
+    uint32_t i, j;
+
+    freq = PalReadCntFrq();
+    src = pal_aligned_alloc(MEM_ALIGN_4K, size);
+    dst = pal_aligned_alloc(MEM_ALIGN_4K, size);
+    if ((freq == 0) || (src == NULL) || (dst == NULL))
+        goto free_buf;
+
+    pal_mem_set(src, size, 0x5A);
+    pal_mem_set(dst, size, 0x5A);
+
+    for (i = 0; i < num_tests; i++) {
+        start = PalReadCntPct();
+        for (j = 0; j < PAL_MEM_BENCH_ITERATIONS; j++) {
+            switch (i) {
+            case 0:
+                pal_memcpy(dst, src, size);
+                break;
+            case 1:
+                pal_memcpy_nontemporal(dst, src, size);
+                break;
+            case 2:
+                pal_mem_set(dst, size, 0xA5);
+                break;
+            case 3:
+                pal_mem_set(dst, size, 0);
+                break;
+            default:
+                (void)pal_mem_compare(src, src + size / 2, size / 2);
+                break;
+            }
+        }
+        ticks = PalReadCntPct() - start;
+        if (ticks == 0)
+            continue;
+
+        /* Bytes per second in hundredths of a GB */
+        rate = (((uint64_t)size * PAL_MEM_BENCH_ITERATIONS * freq) / ticks) / 10000000;
+        print(ACS_PRINT_TEST, "\n %s", name[i]);
+        print(ACS_PRINT_TEST, " : %ld.%02ld GB/s", rate / 100, rate % 100);
     }
+    print(ACS_PRINT_TEST, "\n", 0);
 
-    return (void) buf;
+free_buf:
+    if (src)
+        pal_mem_free_aligned(src);
+    if (dst)
+        pal_mem_free_aligned(dst);
 }
 
 /* The functions implemented below are to enable console prints via UART driver */
@@ -71,6 +71,10 @@ pal_pcc_dump_info_table(PCC_INFO_TABLE *PccInfoTable)
                       ptr_pcc_ss_type_3->cmd_complete_update_preserve);
           print(ACS_PRINT_INFO, "\n Command complete update set mask  : 0x%lx",
                       ptr_pcc_ss_type_3->cmd_complete_update_set);
+          print(ACS_PRINT_INFO, "\n Nominal latency (us)              : 0x%x",
+                      ptr_pcc_ss_type_3->nominal_latency_usec);
+          print(ACS_PRINT_INFO, "\n Platform interrupt                : 0x%x",
+                      ptr_pcc_ss_type_3->platform_intr);
       }
   }
 }
@@ -125,6 +129,18 @@ pal_pcc_create_info_table(PCC_INFO_TABLE *PccInfoTable)
           = platform_pcc_cfg.pcc_info[i].type_spec_info.pcc_ss_type_3.doorbell_write;
         curr_entry->type_spec_info.pcc_ss_type_3.min_req_turnaround_usec
           = platform_pcc_cfg.pcc_info[i].type_spec_info.pcc_ss_type_3.min_req_turnaround_usec;
+        curr_entry->type_spec_info.pcc_ss_type_3.nominal_latency_usec
+          = platform_pcc_cfg.pcc_info[i].type_spec_info.pcc_ss_type_3.nominal_latency_usec;
+        curr_entry->type_spec_info.pcc_ss_type_3.platform_intr
+          = platform_pcc_cfg.pcc_info[i].type_spec_info.pcc_ss_type_3.platform_intr;
+        curr_entry->type_spec_info.pcc_ss_type_3.platform_intr_flags
+          = platform_pcc_cfg.pcc_info[i].type_spec_info.pcc_ss_type_3.platform_intr_flags;
+        curr_entry->type_spec_info.pcc_ss_type_3.platform_intr_ack_reg
+          = platform_pcc_cfg.pcc_info[i].type_spec_info.pcc_ss_type_3.platform_intr_ack_reg;
+        curr_entry->type_spec_info.pcc_ss_type_3.platform_intr_ack_preserve
+          = platform_pcc_cfg.pcc_info[i].type_spec_info.pcc_ss_type_3.platform_intr_ack_preserve;
+        curr_entry->type_spec_info.pcc_ss_type_3.platform_intr_ack_set
+          = platform_pcc_cfg.pcc_info[i].type_spec_info.pcc_ss_type_3.platform_intr_ack_set;
     }
     curr_entry++;
    }
@@ -38,6 +38,12 @@ static uint32_t g_bar32_p_max;
 static uint32_t g_np_bar_size, g_p_bar_size;
 static uint32_t g_np_bus, g_p_bus;
 
+/* Buses reached through bridge windows during enumeration, one bit per bus */
+static uint32_t g_bus_assigned[PCIE_MAX_BUS / 32];
+
+#define PAL_PCIE_BUS_ASSIGNED(bus)  ((g_bus_assigned[(bus) / 32] >> ((bus) % 32)) & 0x1)
+#define PAL_PCIE_SET_BUS_ASSIGNED(bus) (g_bus_assigned[(bus) / 32] |= (1u << ((bus) % 32)))
+
 /**
   @brief   This API reads 32-bit data from PCIe config space pointed by Bus,
            Device, Function and register offset.
@@ -420,6 +426,30 @@ void pal_pcie_program_bar_reg(uint32_t seg, uint32_t bus, uint32_t dev, uint32_t
      g_bar64_p_max =  g_bar64_p_start;
 }
 
+/**
+  @brief   Returns the number of Functions to probe for a device. Functions 1-7
+           are implemented only if Function 0 is present and sets the
+           Multi-Function Device bit in its Header Type register.
+  @param   seg,bus,dev - Segment, Bus(8-bits) & device(8-bits)
+  @return  0 if device is absent, else 1 or PCIE_MAX_FUNC
+**/
+static uint32_t
+pal_pcie_get_num_func(uint32_t seg, uint32_t bus, uint32_t dev)
+{
+  uint32_t vendor_id;
+  uint32_t header_value;
+
+  pal_pci_cfg_read(seg, bus, dev, 0, 0, &vendor_id);
+  if ((vendor_id == 0x0) || (vendor_id == 0xFFFFFFFF))
+      return 0;
+
+  pal_pci_cfg_read(seg, bus, dev, 0, HEADER_OFFSET, &header_value);
+  if (PCIE_HEADER_MFD(header_value))
+      return PCIE_MAX_FUNC;
+
+  return 1;
+}
+
 /**
   @brief   This API performs the PCIe bus enumeration
   @param   bus,sec_bus - Bus(8-bits), secondary bus (8-bits)
@@ -434,6 +464,7 @@ uint32_t pal_pcie_enumerate_device(uint32_t bus, uint32_t sec_bus)
   uint32_t sub_bus = bus;
   uint32_t dev;
   uint32_t func;
+  uint32_t num_func;
   uint32_t class_code;
   uint32_t com_reg_value;
   uint32_t bar32_p_limit;
@@ -443,13 +474,16 @@ uint32_t pal_pcie_enumerate_device(uint32_t bus, uint32_t sec_bus)
   if (bus == ((g_pcie_info_table->block[pcie_index].end_bus_num) + 1))
       return sub_bus;
 
+  PAL_PCIE_SET_BUS_ASSIGNED(bus);
+
   uint32_t bar32_p_base = g_bar32_p_start;
   uint32_t bar32_np_base = g_bar32_np_start;
   uint64_t bar64_p_base = g_bar64_p_start;
 
   for (dev = 0; dev < PCIE_MAX_DEV; dev++)
   {
-    for (func = 0; func < PCIE_MAX_FUNC; func++)
+    num_func = pal_pcie_get_num_func(seg, bus, dev);
+    for (func = 0; func < num_func; func++)
     {
         pal_pci_cfg_read(seg, bus, dev, func, 0, &vendor_id);
         if ((vendor_id == 0x0) || (vendor_id == 0xFFFFFFFF))
@@ -532,6 +566,7 @@ pal_clear_pri_bus()
     uint32_t bus;
     uint32_t dev;
     uint32_t func;
+    uint32_t num_func;
     uint32_t bus_value;
     uint32_t header_value;
     uint32_t vendor_id;
@@ -539,9 +574,14 @@ pal_clear_pri_bus()
     seg = g_pcie_info_table->block[pcie_index].segment_num;
     for (bus = 0; bus <= g_pcie_info_table->block[pcie_index].end_bus_num; bus++)
     {
+        /* Only buses given out during enumeration can hold bridges */
+        if (!PAL_PCIE_BUS_ASSIGNED(bus))
+            continue;
+
         for (dev = 0; dev < PCIE_MAX_DEV; dev++)
         {
-            for (func = 0; func < PCIE_MAX_FUNC; func++)
+            num_func = pal_pcie_get_num_func(seg, bus, dev);
+            for (func = 0; func < num_func; func++)
             {
                 pal_pci_cfg_read(seg, bus, dev, func, 0, &vendor_id);
                 if ((vendor_id == 0x0) || (vendor_id == 0xFFFFFFFF))
@@ -575,6 +615,9 @@ void pal_pcie_enumerate(void)
     g_np_bus       = 0;
     g_p_bus        = 0;
 
+    for (count = 0; count < (PCIE_MAX_BUS / 32); count++)
+        g_bus_assigned[count] = 0;
+
     if (g_pcie_info_table->num_entries == 0)
     {
          print(ACS_PRINT_TEST, "\nSkipping Enumeration", 0);
@@ -624,6 +667,7 @@ pal_pcie_get_bdf(uint32_t ClassCode, uint32_t StartBdf)
   uint32_t  Bus, InputBus, InputSeg;;
   uint32_t  Dev, InputDev;
   uint32_t  Func, InputFunc;
+  uint32_t  NumFunc;
   uint32_t class_code;
   InputSeg  = PCIE_EXTRACT_BDF_SEG(StartBdf);
   InputBus  = PCIE_EXTRACT_BDF_BUS(StartBdf);
@@ -632,9 +676,14 @@ pal_pcie_get_bdf(uint32_t ClassCode, uint32_t StartBdf)
 
   for (Bus = InputBus; Bus < PLATFORM_BM_OVERRIDE_PCIE_MAX_BUS; Bus++)
   {
+    /* Skip buses outside the bridge windows once enumeration is done */
+    if (!enumerate && !PAL_PCIE_BUS_ASSIGNED(Bus))
+      continue;
+
     for (Dev = InputDev; Dev < PCIE_MAX_DEV; Dev++)
     {
-      for (Func = InputFunc; Func < PCIE_MAX_FUNC; Func++)
+      NumFunc = pal_pcie_get_num_func(InputSeg, Bus, Dev);
+      for (Func = InputFunc; Func < NumFunc; Func++)
       {
         pal_pci_cfg_read(InputSeg, Bus, Dev, Func, TYPE01_RIDR, &class_code);
         if ((class_code >> CC_BASE_SHIFT) == (ClassCode >> 16))
@@ -813,6 +862,10 @@ pal_pcie_check_bus_valid(uint32_t bus_index)
   /* Add Bus index to this function if PCIe table
      creation need to be ignored for a bus
   */
-  (void) bus_index;
+
+  /* No Function can respond on a bus outside all bridge windows */
+  if (!enumerate && (bus_index < PCIE_MAX_BUS) && !PAL_PCIE_BUS_ASSIGNED(bus_index))
+      return 1;
+
   return 0;
 }
@@ -21,6 +21,7 @@
 #define PLATFORM_OVERRIDE_PRINT_LEVEL  0x3    //The permissible levels are 1,2,3,4 and 5
 #define PLATFORM_OVERRIDE_BSA_LEVEL    0x1    // The permissible levels are only 1
 #define PLATFORM_OVERRIDE_SBSA_LEVEL   0x7    //The permissible levels are 3,4,5,6 and 7
+#define PLATFORM_OVERRIDE_MEM_BENCHMARK 0x0   //Set to 1 to time the PAL memory helpers at start-up
 
 /*SMBIOS config parameters*/
 #define PLATFORM_OVERRIDE_SMBIOS_SLOT_COUNT       0x1
@@ -1550,10 +1551,16 @@
 #define PLATFORM_PCC_SUBSPACE0_CMD_COMPLETE_CHK_MASK        0x0
 #define PLATFORM_PCC_SUBSPACE0_CMD_UPDATE_PRESERVE          0x0
 #define PLATFORM_PCC_SUBSPACE0_CMD_COMPLETE_UPDATE_SET      0x0
+#define PLATFORM_PCC_SUBSPACE0_NOMINAL_LATENCY              0x0
+#define PLATFORM_PCC_SUBSPACE0_PLATFORM_INTR                0x0
+#define PLATFORM_PCC_SUBSPACE0_PLATFORM_INTR_FLAGS          0x0
+#define PLATFORM_PCC_SUBSPACE0_INTR_ACK_PRESERVE            0x0
+#define PLATFORM_PCC_SUBSPACE0_INTR_ACK_SET                 0x0
 
 /* Following fields follow GENERIC_ADDRESS_STRUCTURE
    defined in platform_override_sbsa_struct.h */
 #define PLATFORM_PCC_SUBSPACE0_DOORBELL_REG                 {0x0, 0x0, 0x0, 0x0, 0xDEADDEAD}
 #define PLATFORM_PCC_SUBSPACE0_CMD_COMPLETE_UPDATE_REG      {0x0, 0x0, 0x0, 0x0, 0xDEADDEAD}
 #define PLATFORM_PCC_SUBSPACE0_CMD_COMPLETE_CHK_REG         {0x0, 0x0, 0x0, 0x0, 0xDEADDEAD}
+#define PLATFORM_PCC_SUBSPACE0_INTR_ACK_REG                 {0x0, 0x0, 0x0, 0x0, 0xDEADDEAD}
 /** End config **/
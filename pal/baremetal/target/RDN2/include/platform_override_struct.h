@@ -472,6 +472,13 @@ typedef struct {
   uint64_t                         cmd_complete_update_preserve;
                                                             /* command complete update preserve */
   uint64_t                         cmd_complete_update_set; /* command complete update set mask */
+  uint32_t                         nominal_latency_usec;    /* expected command latency */
+  uint32_t                         platform_intr;           /* platform interrupt GSIV, 0 if none */
+  uint32_t                         platform_intr_flags;     /* platform interrupt flags */
+  GENERIC_ADDRESS_STRUCTURE        platform_intr_ack_reg;   /* platform interrupt ack register */
+  uint64_t                         platform_intr_ack_preserve;
+                                                            /* platform interrupt ack preserve */
+  uint64_t                         platform_intr_ack_set;   /* platform interrupt ack set mask */
 } PLATFORM_OVERRIDE_PCC_SUBSPACE_TYPE_3;
 
 typedef union {
@@ -917,9 +917,6 @@ pal_peripheral_uart_setup(void)
 
 /** MISC PAL API's */
 
-#define __ADDR_ALIGN_MASK(a, mask)    (((a) + (mask)) & ~(mask))
-#define ADDR_ALIGN(a, b)              __ADDR_ALIGN_MASK(a, (typeof(a))(b) - 1)
-
 void *mem_alloc(size_t alignment, size_t size);
 void mem_free(void *ptr);
 
@@ -928,8 +925,6 @@ typedef struct {
     uint64_t size;
 } val_host_alloc_region_ts;
 
-static uint64_t heap_base;
-static uint64_t heap_top;
 static uint64_t heap_init_done = 0;
 
 /**
@@ -1025,8 +1020,9 @@ pal_mem_alloc_pages (uint32_t NumPages)
 void
 pal_mem_free_pages(void *PageBase, uint32_t NumPages)
 {
-  (void) PageBase;
   (void) NumPages;
+
+  mem_free(PageBase);
 }
 
 /**
@@ -1094,39 +1090,11 @@ pal_mem_free_at_address(uint64_t mem_base,
   (void) Size;
 }
 
-/* Functions implemented below are used to allocate memory from heap. Baremetal implementation
-   of memory allocation.
+/* Functions implemented below are used to allocate memory from heap. The
+   allocator itself lives in pal/baremetal/base/src/pal_heap.c and is shared
+   by all targets; the target only provides the heap region.
 */
 
-static int is_power_of_2(uint32_t n)
-{
-    return n && !(n & (n - 1));
-}
-
-/**
- * @brief Allocates contiguous memory of requested size(no_of_bytes) and alignment.
- * @param alignment - alignment for the address. It must be in power of 2.
- * @param Size - Size of the region. It must not be zero.
- * @return - Returns allocated memory base address if allocation is successful.
- *           Otherwise returns NULL.
- **/
-void *heap_alloc(size_t alignment, size_t size)
-{
-    uint64_t addr;
-
-    addr = ADDR_ALIGN(heap_base, alignment);
-    size += addr - heap_base;
-
-    if ((heap_top - heap_base) < size)
-    {
-       return NULL;
-    }
-
-    heap_base += size;
-
-    return (void *)addr;
-}
-
 /**
  * @brief  Initialisation of allocation data structure
  * @param  void
@@ -1134,8 +1102,7 @@ void *heap_alloc(size_t alignment, size_t size)
  **/
 void mem_alloc_init(void)
 {
-    heap_base = PLATFORM_HEAP_REGION_BASE;
-    heap_top = PLATFORM_HEAP_REGION_BASE + PLATFORM_HEAP_REGION_SIZE;
+    pal_heap_init(PLATFORM_HEAP_REGION_BASE, PLATFORM_HEAP_REGION_SIZE);
     heap_init_done = 1;
 }
 
@@ -1148,40 +1115,23 @@ void mem_alloc_init(void)
  **/
 void *mem_alloc(size_t alignment, size_t size)
 {
-  void *addr = NULL;
-
   if(heap_init_done != 1)
     mem_alloc_init();
 
-  if (size <= 0)
-  {
-    return NULL;
-  }
-
-  if (!is_power_of_2((uint32_t)alignment))
-  {
-    return NULL;
-  }
-
-  size += alignment - 1;
-  addr = heap_alloc(alignment, size);
-
-  return addr;
+  return pal_heap_alloc(alignment, size);
 }
 
 /**
- * TODO: Free the memory for given memory address
- * Currently acs code is initialisazing from base for every test,
- * the regions data structure is internal and below code only setting to zero
- * not actually freeing memory.
- * If require can revisit in future.
+ * @brief Returns memory allocated by mem_alloc to the heap.
+ * @param ptr - Base address returned by mem_alloc.
+ * @return None
  **/
 void mem_free(void *ptr)
 {
   if (!ptr)
     return;
 
-  return;
+  pal_heap_free(ptr);
 }
 
 /**
@@ -1216,9 +1166,10 @@ pal_mem_free_cacheable(uint32_t Bdf, uint32_t Size, void *Va, void *Pa)
 
   (void) Bdf;
   (void) Size;
-  (void) Va;
   (void) Pa;
 
+  mem_free(Va);
+
 }
 
 /** DMA PAL PAI's **/
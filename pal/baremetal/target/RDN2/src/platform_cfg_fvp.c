@@ -1599,5 +1599,17 @@ PLATFORM_OVERRIDE_PCC_INFO_TABLE platform_pcc_cfg = {
     .pcc_info[0].type_spec_info.pcc_ss_type_3.cmd_complete_update_preserve
                                                 = PLATFORM_PCC_SUBSPACE0_CMD_UPDATE_PRESERVE,
     .pcc_info[0].type_spec_info.pcc_ss_type_3.cmd_complete_update_set
-                                                = PLATFORM_PCC_SUBSPACE0_CMD_COMPLETE_UPDATE_SET
+                                                = PLATFORM_PCC_SUBSPACE0_CMD_COMPLETE_UPDATE_SET,
+    .pcc_info[0].type_spec_info.pcc_ss_type_3.nominal_latency_usec
+                                                = PLATFORM_PCC_SUBSPACE0_NOMINAL_LATENCY,
+    .pcc_info[0].type_spec_info.pcc_ss_type_3.platform_intr
+                                                = PLATFORM_PCC_SUBSPACE0_PLATFORM_INTR,
+    .pcc_info[0].type_spec_info.pcc_ss_type_3.platform_intr_flags
+                                                = PLATFORM_PCC_SUBSPACE0_PLATFORM_INTR_FLAGS,
+    .pcc_info[0].type_spec_info.pcc_ss_type_3.platform_intr_ack_reg
+                                                = PLATFORM_PCC_SUBSPACE0_INTR_ACK_REG,
+    .pcc_info[0].type_spec_info.pcc_ss_type_3.platform_intr_ack_preserve
+                                                = PLATFORM_PCC_SUBSPACE0_INTR_ACK_PRESERVE,
+    .pcc_info[0].type_spec_info.pcc_ss_type_3.platform_intr_ack_set
+                                                = PLATFORM_PCC_SUBSPACE0_INTR_ACK_SET
 };
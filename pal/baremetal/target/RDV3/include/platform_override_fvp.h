@@ -19,6 +19,7 @@
 #define PLATFORM_OVERRIDE_PRINT_LEVEL        0x3     /* Console log level (1-5)                  */
 #define PLATFORM_OVERRIDE_BSA_LEVEL          0x1     /* Target BSA compliance level (only 1)     */
 #define PLATFORM_OVERRIDE_SBSA_LEVEL         0x7     /* Target SBSA compliance level (3-7)       */
+#define PLATFORM_OVERRIDE_MEM_BENCHMARK      0x0     /* 1: time PAL memory helpers at start-up   */
 
 /* ------------------------------  MMU page table ------------------------------ */
 #define PLATFORM_PAGE_SIZE              0x1000       /* MMU Memory Page Size                     */
@@ -1397,10 +1398,16 @@
 #define PLATFORM_PCC_SUBSPACE0_CMD_COMPLETE_CHK_MASK        0x0
 #define PLATFORM_PCC_SUBSPACE0_CMD_UPDATE_PRESERVE          0x0
 #define PLATFORM_PCC_SUBSPACE0_CMD_COMPLETE_UPDATE_SET      0x0
+#define PLATFORM_PCC_SUBSPACE0_NOMINAL_LATENCY              0x0
+#define PLATFORM_PCC_SUBSPACE0_PLATFORM_INTR                0x0
+#define PLATFORM_PCC_SUBSPACE0_PLATFORM_INTR_FLAGS          0x0
+#define PLATFORM_PCC_SUBSPACE0_INTR_ACK_PRESERVE            0x0
+#define PLATFORM_PCC_SUBSPACE0_INTR_ACK_SET                 0x0
 
 /* Following fields follow GENERIC_ADDRESS_STRUCTURE
    defined in platform_override_sbsa_struct.h */
 #define PLATFORM_PCC_SUBSPACE0_DOORBELL_REG                 {0x0, 0x0, 0x0, 0x0, 0xDEADDEAD}
 #define PLATFORM_PCC_SUBSPACE0_CMD_COMPLETE_UPDATE_REG      {0x0, 0x0, 0x0, 0x0, 0xDEADDEAD}
 #define PLATFORM_PCC_SUBSPACE0_CMD_COMPLETE_CHK_REG         {0x0, 0x0, 0x0, 0x0, 0xDEADDEAD}
+#define PLATFORM_PCC_SUBSPACE0_INTR_ACK_REG                 {0x0, 0x0, 0x0, 0x0, 0xDEADDEAD}
 /** End config **/
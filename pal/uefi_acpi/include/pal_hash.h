@@ -0,0 +1,59 @@
+/** @file
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __PAL_HASH_H__
+#define __PAL_HASH_H__
+
+/* Open addressed hash tables of UINT32 keys with linear probing, used to index ACPI
+   tables while they are parsed. A table has a power of two number of slots, and every
+   slot starts with a PAL_HASH_SLOT_HDR; the rest of the slot belongs to the user. */
+#define PAL_HASH_MULT   0x9E3779B1
+#define PAL_HASH_EMPTY  0xFFFFFFFF   /* Value of an unused slot */
+
+typedef struct {
+  UINT32 Key;
+  UINT32 Value;   /* PAL_HASH_EMPTY for an unused slot */
+} PAL_HASH_SLOT_HDR;
+
+/**
+  @brief  Find the slot of a key, or the unused slot where it would be added.
+          The table must always have at least one unused slot.
+
+  @param  Slots     Pointer to the first slot.
+  @param  SlotSize  Size of one slot in bytes.
+  @param  Mask      Number of slots minus one.
+  @param  Key       Key to look up.
+
+  @return Index of the slot.
+**/
+STATIC INLINE
+UINT32
+pal_hash_probe(VOID *Slots, UINTN SlotSize, UINT32 Mask, UINT32 Key)
+{
+  PAL_HASH_SLOT_HDR *Slot;
+  UINT32            Hash;
+  UINT32            Idx;
+
+  Hash = Key * PAL_HASH_MULT;
+  for (Idx = (Hash ^ (Hash >> 16)) & Mask; ; Idx = (Idx + 1) & Mask) {
+    Slot = (PAL_HASH_SLOT_HDR *)((UINT8 *)Slots + Idx * SlotSize);
+    if ((Slot->Value == PAL_HASH_EMPTY) || (Slot->Key == Key))
+      return Idx;
+  }
+}
+
+#endif
@@ -28,6 +28,7 @@
 #define PLATFORM_TIMEOUT_MEDIUM 0x1000
 
 UINT64 pal_get_acpi_table_ptr(UINT32 table_signature);
+UINT64 pal_get_acpi_table_instance_ptr(UINT32 table_signature, UINT32 instance);
 
 extern VOID* g_acs_log_file_handle;
 extern UINT32 g_print_level;
@@ -152,6 +153,14 @@ VOID     pal_pe_data_cache_ops_by_va(UINT64 addr, UINT32 type);
 #define CLEAN                 0x2
 #define INVALIDATE            0x3
 
+/* Log file sink modes, see pal_log_set_mode */
+#define PAL_LOG_CONSOLE       0x0
+#define PAL_LOG_BUFFERED      0x1
+#define PAL_LOG_UNBUFFERED    0x2
+
+VOID     pal_log_flush(VOID);
+VOID     pal_log_set_mode(UINT32 mode);
+
 typedef struct {
   UINT32   gic_version;
   UINT32   num_gicd;
@@ -590,6 +599,14 @@ typedef struct {
   UINT64                            cmd_complete_update_preserve;
                                                              /* command complete update preserve */
   UINT64                            cmd_complete_update_set; /* command complete update set mask */
+  UINT32                            nominal_latency_usec;    /* expected command latency */
+  UINT32                            platform_intr;           /* platform interrupt GSIV, 0 if none */
+  UINT32                            platform_intr_flags;     /* platform interrupt flags */
+  EFI_ACPI_6_5_GENERIC_ADDRESS_STRUCTURE
+                                    platform_intr_ack_reg;   /* platform interrupt ack register */
+  UINT64                            platform_intr_ack_preserve;
+                                                             /* platform interrupt ack preserve */
+  UINT64                            platform_intr_ack_set;   /* platform interrupt ack set mask */
 } PCC_SUBSPACE_TYPE_3;
 
 typedef union {
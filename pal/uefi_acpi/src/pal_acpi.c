@@ -28,6 +28,7 @@
 #include "Include/IndustryStandard/Acpi61.h"
 
 #include "include/pal_uefi.h"
+#include "include/pal_hash.h"
 #include "include/pal_pmu.h"
 #include "include/pal_mpam.h"
 
@@ -99,142 +100,222 @@ pal_get_xsdt_ptr()
 
 }
 
+/* Directory of the tables listed in XSDT, built in one XSDT walk on first use. Signatures
+   hash to a slot, see pal_hash.h, instances of one signature (e.g. SSDTs) are chained in
+   XSDT order. */
+#define ACPI_DIR_END          PAL_HASH_EMPTY
+#define ACPI_DIR_NOT_BUILT    0
+#define ACPI_DIR_BUILT        1
+#define ACPI_DIR_UNAVAILABLE  2   /* Allocation failed, walk XSDT on every lookup */
+
+typedef struct {
+  UINT32 Signature; /* PAL_HASH_SLOT_HDR Key */
+  UINT32 First;     /* PAL_HASH_SLOT_HDR Value: index of the first instance in
+                       g_acpi_dir_table, ACPI_DIR_END if unused */
+  UINT32 Last;      /* Index of the last instance, new instances are chained after it */
+} ACPI_DIR_SLOT;
+
+typedef struct {
+  UINT64 Address;
+  UINT32 Next;    /* Index of the next instance of the same signature */
+} ACPI_DIR_ENTRY;
+
+STATIC ACPI_DIR_SLOT  *g_acpi_dir_slot;
+STATIC ACPI_DIR_ENTRY *g_acpi_dir_table;
+STATIC UINT32         g_acpi_dir_mask;
+STATIC UINT32         g_acpi_dir_state = ACPI_DIR_NOT_BUILT;
+
 /**
-  @brief  Iterate through the tables pointed by XSDT and return MADT address
+  @brief  Return the directory slot of a signature, or the free slot where it would be added.
 
-  @param  None
+  @param  Signature ACPI table signature.
 
-  @return 64-bit MADT address
+  @return Pointer to the slot.
 **/
-UINT64
-pal_get_madt_ptr()
+STATIC ACPI_DIR_SLOT *
+pal_acpi_dir_slot(UINT32 Signature)
 {
+  return &g_acpi_dir_slot[pal_hash_probe(g_acpi_dir_slot, sizeof(ACPI_DIR_SLOT),
+                                         g_acpi_dir_mask, Signature)];
+}
 
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
+/**
+  @brief  Walk XSDT once and record every table in the directory. The slot array has at least
+          twice as many entries as XSDT, so lookups stay O(1).
 
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
+  @param  Xsdt Pointer to XSDT.
+
+  @return None
+**/
+STATIC VOID
+pal_acpi_dir_build(EFI_ACPI_DESCRIPTION_HEADER *Xsdt)
+{
+  ACPI_DIR_SLOT *Slot;
+  UINT64        *Entry64;
+  UINT32        Entry64Num;
+  UINT32        Signature;
+  UINT32        Size = 16;
+  UINT32        Idx;
 
   Entry64  = (UINT64 *)(Xsdt + 1);
   Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
+
+  while (Size < 2 * Entry64Num)
+    Size <<= 1;
+
+  g_acpi_dir_slot = pal_mem_alloc(Size * sizeof(ACPI_DIR_SLOT));
+  g_acpi_dir_table = pal_mem_alloc((Entry64Num + 1) * sizeof(ACPI_DIR_ENTRY));
+  if ((g_acpi_dir_slot == NULL) || (g_acpi_dir_table == NULL)) {
+    if (g_acpi_dir_slot != NULL)
+      pal_mem_free(g_acpi_dir_slot);
+    if (g_acpi_dir_table != NULL)
+      pal_mem_free(g_acpi_dir_table);
+    g_acpi_dir_state = ACPI_DIR_UNAVAILABLE;
+    return;
+  }
+
+  g_acpi_dir_mask = Size - 1;
+  for (Idx = 0; Idx < Size; Idx++)
+    g_acpi_dir_slot[Idx].First = ACPI_DIR_END;
+
   for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) == EFI_ACPI_6_1_MULTIPLE_APIC_DESCRIPTION_TABLE_SIGNATURE) {
-        return(UINT64)(Entry64[Idx]);
+    g_acpi_dir_table[Idx].Address = Entry64[Idx];
+    g_acpi_dir_table[Idx].Next = ACPI_DIR_END;
+    if (Entry64[Idx] == 0)
+      continue;
+
+    Signature = *(UINT32 *)(UINTN)(Entry64[Idx]);
+    Slot = pal_acpi_dir_slot(Signature);
+    if (Slot->First == ACPI_DIR_END) {
+      Slot->Signature = Signature;
+      Slot->First = Idx;
+    } else {
+      g_acpi_dir_table[Slot->Last].Next = Idx;
     }
+    Slot->Last = Idx;
   }
 
-  return 0;
-
+  g_acpi_dir_state = ACPI_DIR_BUILT;
 }
 
 /**
-  @brief  Iterate through the tables pointed by XSDT and return GTDT address
+  @brief  Return an instance of an ACPI table. Instances are numbered in XSDT order, so tables
+          that may appear more than once such as SSDT can be iterated from instance 0 until
+          zero is returned.
 
-  @param  None
+  @param  table_signature Signature of the requested ACPI table.
+  @param  instance Zero based instance of the table.
 
-  @return 64-bit GTDT address
+  @return 64-bit ACPI table address if found, else zero is returned.
 **/
 UINT64
-pal_get_gtdt_ptr()
+pal_get_acpi_table_instance_ptr(UINT32 table_signature, UINT32 instance)
 {
-
   EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
+  ACPI_DIR_SLOT                 *Slot;
   UINT64                        *Entry64;
   UINT32                        Entry64Num;
   UINT32                        Idx;
 
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
+  if (g_acpi_dir_state != ACPI_DIR_BUILT) {
+    Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
+    if (Xsdt == NULL) {
+        acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
+        return 0;
+    }
+
+    if (g_acpi_dir_state == ACPI_DIR_NOT_BUILT)
+      pal_acpi_dir_build(Xsdt);
+
+    if (g_acpi_dir_state == ACPI_DIR_UNAVAILABLE) {
+      Entry64  = (UINT64 *)(Xsdt + 1);
+      Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
+      for (Idx = 0; Idx < Entry64Num; Idx++) {
+        if ((Entry64[Idx] != 0) && (*(UINT32 *)(UINTN)(Entry64[Idx]) == table_signature)) {
+          if (instance-- == 0)
+            return(UINT64)(Entry64[Idx]);
+        }
+      }
       return 0;
+    }
   }
 
-  Entry64  = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) == EFI_ACPI_6_1_GENERIC_TIMER_DESCRIPTION_TABLE_SIGNATURE) {
-        return(UINT64)(Entry64[Idx]);
-    }
+  Slot = pal_acpi_dir_slot(table_signature);
+  for (Idx = Slot->First; Idx != ACPI_DIR_END; Idx = g_acpi_dir_table[Idx].Next) {
+    if (instance-- == 0)
+      return g_acpi_dir_table[Idx].Address;
   }
 
   return 0;
+}
 
+/**
+  @brief  Return the first instance of an ACPI table listed in XSDT.
+
+  @param  table_signature Signature of the requested ACPI table.
+
+  @return 64-bit ACPI table address if found, else zero is returned.
+**/
+UINT64
+pal_get_acpi_table_ptr(UINT32 table_signature)
+{
+  return pal_get_acpi_table_instance_ptr(table_signature, 0);
 }
 
 /**
-  @brief  Iterate through the tables pointed by XSDT and return MCFG Table address
+  @brief  Return MADT address from the ACPI table directory
 
   @param  None
 
-  @return 64-bit MCFG address
+  @return 64-bit MADT address
 **/
 UINT64
-pal_get_mcfg_ptr()
+pal_get_madt_ptr()
 {
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
-
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
+  return pal_get_acpi_table_ptr(EFI_ACPI_6_1_MULTIPLE_APIC_DESCRIPTION_TABLE_SIGNATURE);
+}
 
-  Entry64  = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) == EFI_ACPI_6_1_PCI_EXPRESS_MEMORY_MAPPED_CONFIGURATION_SPACE_BASE_ADDRESS_DESCRIPTION_TABLE_SIGNATURE) {
-        return(UINT64)(Entry64[Idx]);
-    }
-  }
+/**
+  @brief  Return GTDT address from the ACPI table directory
 
-  return 0;
+  @param  None
 
+  @return 64-bit GTDT address
+**/
+UINT64
+pal_get_gtdt_ptr()
+{
+  return pal_get_acpi_table_ptr(EFI_ACPI_6_1_GENERIC_TIMER_DESCRIPTION_TABLE_SIGNATURE);
 }
 
 /**
-  @brief  Iterate through the tables pointed by XSDT and return SPCR Table address
+  @brief  Return MCFG Table address from the ACPI table directory
 
   @param  None
 
-  @return 64-bit SPCR address
+  @return 64-bit MCFG address
 **/
 UINT64
-pal_get_spcr_ptr()
+pal_get_mcfg_ptr()
 {
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
-
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
+  return pal_get_acpi_table_ptr(EFI_ACPI_6_1_PCI_EXPRESS_MEMORY_MAPPED_CONFIGURATION_SPACE_BASE_ADDRESS_DESCRIPTION_TABLE_SIGNATURE);
+}
 
-  Entry64  = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) == EFI_ACPI_2_0_SERIAL_PORT_CONSOLE_REDIRECTION_TABLE_SIGNATURE) {
-        return(UINT64)(Entry64[Idx]);
-    }
-  }
+/**
+  @brief  Return SPCR Table address from the ACPI table directory
 
-  return 0;
+  @param  None
 
+  @return 64-bit SPCR address
+**/
+UINT64
+pal_get_spcr_ptr()
+{
+  return pal_get_acpi_table_ptr(EFI_ACPI_2_0_SERIAL_PORT_CONSOLE_REDIRECTION_TABLE_SIGNATURE);
 }
 
 /**
-  @brief  Iterate through the tables pointed by XSDT and return IORT Table address
+  @brief  Return IORT Table address from the ACPI table directory
 
   @param  None
 
@@ -243,35 +324,15 @@ pal_get_spcr_ptr()
 UINT64
 pal_get_iort_ptr()
 {
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
-
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
-
-  Entry64  = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
 #ifdef EFI_ACPI_6_1_IO_REMAPPING_TABLE_SIGNATURE
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) == EFI_ACPI_6_1_IO_REMAPPING_TABLE_SIGNATURE) {
+  return pal_get_acpi_table_ptr(EFI_ACPI_6_1_IO_REMAPPING_TABLE_SIGNATURE);
 #else
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) == EFI_ACPI_6_1_INTERRUPT_SOURCE_OVERRIDE_SIGNATURE) {
+  return pal_get_acpi_table_ptr(EFI_ACPI_6_1_INTERRUPT_SOURCE_OVERRIDE_SIGNATURE);
 #endif
-        return(UINT64)(Entry64[Idx]);
-    }
-  }
-
-  return 0;
-
 }
 
 /**
-  @brief   Iterate through the tables pointed by XSDT and return FADT Table address
+  @brief   Return FADT Table address from the ACPI table directory
   @param   None
   @return  64-bit address of FADT table
   @retval  0:  FADT table could not be found
@@ -281,63 +342,11 @@ pal_get_fadt_ptr (
   VOID
   )
 {
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
-
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
-
-  Entry64 = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof (EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) == EFI_ACPI_6_1_FIXED_ACPI_DESCRIPTION_TABLE_SIGNATURE) {
-      return (UINT64)(Entry64[Idx]);
-    }
-  }
-
-  return 0;
+  return pal_get_acpi_table_ptr(EFI_ACPI_6_1_FIXED_ACPI_DESCRIPTION_TABLE_SIGNATURE);
 }
 
 /**
-  @brief  Iterate through the ACPI tables pointed by XSDT and return table address.
-
-  @param  table_signature Signature of the requested ACPI table.
-
-  @return 64-bit ACPI table address if found, else zero is returned.
-**/
-UINT64
-pal_get_acpi_table_ptr(UINT32 table_signature)
-{
-
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
-
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
-
-  Entry64  = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) == table_signature) {
-        return(UINT64)(Entry64[Idx]);
-    }
-  }
-
-  return 0;
-}
-
-/**
-    @brief  Iterate through the tables pointed by XSDT and return AEST Table address
+    @brief  Return AEST Table address from the ACPI table directory
 
     @param  None
 
@@ -346,30 +355,11 @@ pal_get_acpi_table_ptr(UINT32 table_signature)
 UINT64
 pal_get_aest_ptr()
 {
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
-
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
-
-  Entry64  = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) == EFI_ACPI_6_3_ARM_ERROR_SOURCE_TABLE_SIGNATURE) {
-      return(UINT64)(Entry64[Idx]);
-    }
-  }
-
-  return 0;
+  return pal_get_acpi_table_ptr(EFI_ACPI_6_3_ARM_ERROR_SOURCE_TABLE_SIGNATURE);
 }
 
   /**
-    @brief  Iterate through the tables pointed by XSDT and return APMT Table address
+    @brief  Return APMT Table address from the ACPI table directory
 
     @param  None
 
@@ -378,30 +368,11 @@ pal_get_aest_ptr()
 UINT64
 pal_get_apmt_ptr()
 {
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
-
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
-
-  Entry64  = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) == ARM_PERFORMANCE_MONITORING_TABLE_SIGNATURE) {
-      return(UINT64)(Entry64[Idx]);
-    }
-  }
-
-  return 0;
+  return pal_get_acpi_table_ptr(ARM_PERFORMANCE_MONITORING_TABLE_SIGNATURE);
 }
 
 /**
-  @brief  Iterate through the tables pointed by XSDT and return HMAT address
+  @brief  Return HMAT address from the ACPI table directory
 
   @param  None
 
@@ -410,32 +381,11 @@ pal_get_apmt_ptr()
 UINT64
 pal_get_hmat_ptr(void)
 {
-
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
-
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
-
-  Entry64  = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) ==
-        EFI_ACPI_6_4_HETEROGENEOUS_MEMORY_ATTRIBUTE_TABLE_SIGNATURE) {
-        return(UINT64)(Entry64[Idx]);
-    }
-  }
-
-  return 0;
+  return pal_get_acpi_table_ptr(EFI_ACPI_6_4_HETEROGENEOUS_MEMORY_ATTRIBUTE_TABLE_SIGNATURE);
 }
 
   /**
-    @brief  Iterate through the tables pointed by XSDT and return MPAM Table address
+    @brief  Return MPAM Table address from the ACPI table directory
 
     @param  None
 
@@ -444,31 +394,11 @@ pal_get_hmat_ptr(void)
 UINT64
 pal_get_mpam_ptr()
 {
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
-
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
-
-  Entry64  = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) ==
-                MEMORY_RESOURCE_PARTITIONING_AND_MONITORING_TABLE_SIGNATURE) {
-      return(UINT64)(Entry64[Idx]);
-    }
-  }
-
-  return 0;
+  return pal_get_acpi_table_ptr(MEMORY_RESOURCE_PARTITIONING_AND_MONITORING_TABLE_SIGNATURE);
 }
 
 /**
-  @brief  Iterate through the tables pointed by XSDT and return PPTT address
+  @brief  Return PPTT address from the ACPI table directory
 
   @param  None
 
@@ -477,32 +407,12 @@ pal_get_mpam_ptr()
 UINT64
 pal_get_pptt_ptr(void)
 {
-
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
-
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
-
-  Entry64  = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) ==
-        EFI_ACPI_6_4_PROCESSOR_PROPERTIES_TOPOLOGY_TABLE_STRUCTURE_SIGNATURE) {
-        return (UINT64)(Entry64[Idx]);
-    }
-  }
-
-  return 0;
+  return pal_get_acpi_table_ptr(
+           EFI_ACPI_6_4_PROCESSOR_PROPERTIES_TOPOLOGY_TABLE_STRUCTURE_SIGNATURE);
 }
 
 /**
-  @brief  Iterate through the tables pointed by XSDT and return SRAT address
+  @brief  Return SRAT address from the ACPI table directory
 
   @param  None
 
@@ -511,32 +421,11 @@ pal_get_pptt_ptr(void)
 UINT64
 pal_get_srat_ptr(void)
 {
-
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
-
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
-
-  Entry64  = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) ==
-        EFI_ACPI_3_0_SYSTEM_RESOURCE_AFFINITY_TABLE_SIGNATURE) {
-        return(UINT64)(Entry64[Idx]);
-    }
-  }
-
-  return 0;
+  return pal_get_acpi_table_ptr(EFI_ACPI_3_0_SYSTEM_RESOURCE_AFFINITY_TABLE_SIGNATURE);
 }
 
 /**
-  @brief  Iterate through the tables pointed by XSDT and return TPM2 table address
+  @brief  Return TPM2 table address from the ACPI table directory
 
   @param  None
 
@@ -545,28 +434,7 @@ pal_get_srat_ptr(void)
 UINT64
 pal_get_tpm2_ptr(void)
 {
-  EFI_ACPI_DESCRIPTION_HEADER   *Xsdt;
-  UINT64                        *Entry64;
-  UINT32                        Entry64Num;
-  UINT32                        Idx;
-
-  Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *) pal_get_xsdt_ptr();
-  if (Xsdt == NULL) {
-      acs_print(ACS_PRINT_ERR, L" XSDT not found\n");
-      return 0;
-  }
-
-  Entry64  = (UINT64 *)(Xsdt + 1);
-  Entry64Num = (Xsdt->Length - sizeof(EFI_ACPI_DESCRIPTION_HEADER)) >> 3;
-
-  for (Idx = 0; Idx < Entry64Num; Idx++) {
-    if (*(UINT32 *)(UINTN)(Entry64[Idx]) ==
-        EFI_ACPI_6_1_TRUSTED_COMPUTING_PLATFORM_2_TABLE_SIGNATURE) {
-        return (UINT64)(Entry64[Idx]);
-    }
-  }
-
-  return 0;
+  return pal_get_acpi_table_ptr(EFI_ACPI_6_1_TRUSTED_COMPUTING_PLATFORM_2_TABLE_SIGNATURE);
 }
 
 
@@ -24,6 +24,17 @@
 #include "include/pal_uefi.h"
 
 UINT8   *gSharedMemory;
+STATIC UINTN gSharedMemoryPages;
+
+/* Log file sink: in PAL_LOG_BUFFERED mode formatted pal_print fragments are
+   staged here and written to the log file in large batches instead of one
+   ShellWriteFile each */
+#define PAL_LOG_BUF_SIZE  0x10000
+
+STATIC CHAR8  gLogBuffer[PAL_LOG_BUF_SIZE];
+STATIC UINTN  gLogLength;
+STATIC UINT32 gLogMode = PAL_LOG_UNBUFFERED;
+STATIC UINT32 gLogModule;
 
 /**
  @brief This API provides a single point of abstraction to write 8-bit
@@ -186,6 +197,83 @@ pal_mmio_write(UINT64 addr, UINT32 data)
   *(volatile UINT32 *)addr = data;
 }
 
+/**
+  @brief  Write the staged log fragments to the log file
+
+  @param  None
+
+  @return None
+**/
+VOID
+pal_log_flush(VOID)
+{
+  EFI_STATUS Status;
+  UINTN      Length = gLogLength;
+
+  if (Length == 0)
+    return;
+
+  gLogLength = 0;
+  if (!g_acs_log_file_handle)
+    return;
+
+  Status = ShellWriteFile(g_acs_log_file_handle, &Length, (VOID *)gLogBuffer);
+  if (EFI_ERROR(Status))
+    acs_print(ACS_PRINT_ERR, L" Error in writing to log file\n");
+}
+
+/**
+  @brief  Select how pal_print output reaches the log file. Staged fragments
+          are flushed before the mode changes.
+
+  @param  mode  PAL_LOG_BUFFERED    - batch writes
+                PAL_LOG_UNBUFFERED  - one write per fragment (default)
+                PAL_LOG_CONSOLE     - console only, no log file writes
+
+  @return None
+**/
+VOID
+pal_log_set_mode(UINT32 mode)
+{
+  pal_log_flush();
+  gLogMode = mode;
+}
+
+/**
+  @brief  Append one formatted fragment to the log file sink. The staging
+          buffer is flushed when it fills up and whenever the current test
+          module changes.
+
+  @param  Buffer  Formatted fragment
+  @param  Length  Length of the fragment in bytes
+
+  @return None
+**/
+STATIC
+VOID
+pal_log_write(CHAR8 *Buffer, UINTN Length)
+{
+  EFI_STATUS Status;
+
+  if (gLogMode == PAL_LOG_CONSOLE)
+    return;
+
+  if (gLogMode == PAL_LOG_UNBUFFERED) {
+    Status = ShellWriteFile(g_acs_log_file_handle, &Length, (VOID *)Buffer);
+    if (EFI_ERROR(Status))
+      acs_print(ACS_PRINT_ERR, L" Error in writing to log file\n");
+    return;
+  }
+
+  if ((gLogModule != g_curr_module) || (gLogLength + Length > PAL_LOG_BUF_SIZE)) {
+    pal_log_flush();
+    gLogModule = g_curr_module;
+  }
+
+  CopyMem(&gLogBuffer[gLogLength], Buffer, Length);
+  gLogLength += Length;
+}
+
 /**
   @brief  Sends a formatted string to the output console
 
@@ -201,12 +289,9 @@ pal_print(CHAR8 *string, UINT64 data)
   {
     CHAR8 Buffer[1024];
     UINTN BufferSize = 1;
-    EFI_STATUS Status = 0;
     BufferSize = AsciiSPrint(Buffer, 1024, string, data);
     AsciiPrint(Buffer);
-    Status = ShellWriteFile(g_acs_log_file_handle, &BufferSize, (VOID*)Buffer);
-    if(EFI_ERROR(Status))
-      acs_print(ACS_PRINT_ERR, L" Error in writing to log file\n");
+    pal_log_write(Buffer, BufferSize);
   } else
       AsciiPrint(string, data);
 }
@@ -308,7 +393,9 @@ pal_mem_set (
 }
 
 /**
-  @brief  Allocate memory which is to be used to share data across PEs
+  @brief  Allocate memory which is to be used to share data across PEs.
+          The region is page aligned so that per-PE entries padded to the
+          cache writeback granule never share a cache line.
 
   @param  num_pe      - Number of PEs in the system
   @param  sizeofentry - Size of memory region allocated to each PE
@@ -319,17 +406,24 @@ VOID
 pal_mem_allocate_shared(UINT32 num_pe, UINT32 sizeofentry)
 {
   EFI_STATUS Status;
-  gSharedMemory = 0;
+  EFI_PHYSICAL_ADDRESS Address;
 
-  Status = gBS->AllocatePool ( EfiBootServicesData,
-                               (num_pe * sizeofentry),
-                               (VOID **) &gSharedMemory );
+  gSharedMemory = 0;
+  gSharedMemoryPages = EFI_SIZE_TO_PAGES((UINTN)num_pe * sizeofentry);
 
-  acs_print(ACS_PRINT_INFO, L" Shared memory is %llx\n", gSharedMemory);
+  Status = gBS->AllocatePages (AllocateAnyPages,
+                               EfiBootServicesData,
+                               gSharedMemoryPages,
+                               &Address);
 
   if (EFI_ERROR(Status)) {
-    acs_print(ACS_PRINT_ERR, L" Allocate Pool shared memory failed %x\n", Status);
+    acs_print(ACS_PRINT_ERR, L" Allocate Pages shared memory failed %x\n", Status);
+    gSharedMemoryPages = 0;
+  } else {
+    gSharedMemory = (UINT8 *)(UINTN)Address;
   }
+
+  acs_print(ACS_PRINT_INFO, L" Shared memory is %llx\n", gSharedMemory);
   pal_pe_data_cache_ops_by_va((UINT64)&gSharedMemory, CLEAN_AND_INVALIDATE);
 
   return;
@@ -361,7 +455,12 @@ pal_mem_get_shared_addr()
 VOID
 pal_mem_free_shared()
 {
-  gBS->FreePool ((VOID *)gSharedMemory);
+  if (gSharedMemoryPages == 0)
+    return;
+
+  gBS->FreePages ((EFI_PHYSICAL_ADDRESS)(UINTN)gSharedMemory, gSharedMemoryPages);
+  gSharedMemory = 0;
+  gSharedMemoryPages = 0;
 }
 
 /**
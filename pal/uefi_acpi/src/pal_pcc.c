@@ -109,6 +109,14 @@ pal_pcc_store_info(UINT32 subspace_idx)
         ptr_to_pcc_ss_type_3->doorbell_write            =  pcct_type_3->DoorbellWrite;
         ptr_to_pcc_ss_type_3->cmd_complete_chk_mask     =  pcct_type_3->CommandCompleteCheckMask;
         ptr_to_pcc_ss_type_3->cmd_complete_update_set   =  pcct_type_3->CommandCompleteUpdateSet;
+        ptr_to_pcc_ss_type_3->nominal_latency_usec      =  pcct_type_3->NominalLatency;
+        ptr_to_pcc_ss_type_3->platform_intr             =  pcct_type_3->PlatformInterrupt;
+        ptr_to_pcc_ss_type_3->platform_intr_flags       =  pcct_type_3->PlatformInterruptFlags;
+        ptr_to_pcc_ss_type_3->platform_intr_ack_reg
+                    = pcct_type_3->PlatformInterruptAckRegister;
+        ptr_to_pcc_ss_type_3->platform_intr_ack_preserve
+                                            =  pcct_type_3->PlatformInterruptAckPreserve;
+        ptr_to_pcc_ss_type_3->platform_intr_ack_set     =  pcct_type_3->PlatformInterruptAckSet;
         g_pcc_info_table->subspace_cnt++;
 
         break;
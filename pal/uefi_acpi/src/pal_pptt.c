@@ -24,11 +24,99 @@
 #include <Protocol/Cpu.h>
 
 #include "include/pal_uefi.h"
+#include "include/pal_hash.h"
 
 UINT64 pal_get_pptt_ptr(void);
 #define ADD_PTR(t, p, l) ((t *)((UINT8 *)p + l))
 #define PPTT_PE_PRIV_RES_OFFSET 0x14
 #define PPTT_STRUCT_OFFSET 0x24
+#define PPTT_INDEX_EMPTY PAL_HASH_EMPTY
+
+/* Hash of UINT32 keys to table indices, see pal_hash.h, used for PPTT offset -> cache index
+   and ACPI UID -> PE index lookups while building the cache info table */
+typedef struct {
+  PAL_HASH_SLOT_HDR *slot;
+  UINT32 mask;
+} PPTT_INDEX;
+
+/**
+  @brief  Allocate a hash with at least twice as many slots as keys, so probe chains stay short.
+  @param  Index Pointer to the hash to initialize.
+  @param  num_keys Maximum number of keys that will be added.
+  @return 0 on success, 1 if memory is not available. The hash is then left empty.
+**/
+STATIC UINT32
+pal_pptt_index_init(PPTT_INDEX *Index, UINT32 num_keys)
+{
+  UINT32 size = 16;
+  UINT32 i;
+
+  while (size < 2 * num_keys)
+    size <<= 1;
+
+  Index->mask = 0;
+  Index->slot = pal_mem_alloc(size * sizeof(PAL_HASH_SLOT_HDR));
+  if (Index->slot == NULL)
+    return 1;
+
+  for (i = 0; i < size; i++)
+    Index->slot[i].Value = PPTT_INDEX_EMPTY;
+
+  Index->mask = size - 1;
+  return 0;
+}
+
+STATIC VOID
+pal_pptt_index_free(PPTT_INDEX *Index)
+{
+  if (Index->slot != NULL)
+    pal_mem_free(Index->slot);
+
+  Index->slot = NULL;
+  Index->mask = 0;
+}
+
+/**
+  @brief  Look up a key in the hash.
+  @param  Index Pointer to the hash.
+  @param  key Key to look up.
+  @return Value stored for the key, PPTT_INDEX_EMPTY if not present.
+**/
+STATIC UINT32
+pal_pptt_index_find(PPTT_INDEX *Index, UINT32 key)
+{
+  UINT32 i;
+
+  if (Index->slot == NULL)
+    return PPTT_INDEX_EMPTY;
+
+  /* An unused slot holds PPTT_INDEX_EMPTY */
+  i = pal_hash_probe(Index->slot, sizeof(PAL_HASH_SLOT_HDR), Index->mask, key);
+  return Index->slot[i].Value;
+}
+
+/**
+  @brief  Add a key to the hash, the first value added for a key is kept.
+  @param  Index Pointer to the hash.
+  @param  key Key to add.
+  @param  value Value to store, must not be PPTT_INDEX_EMPTY.
+  @return None
+**/
+STATIC VOID
+pal_pptt_index_add(PPTT_INDEX *Index, UINT32 key, UINT32 value)
+{
+  UINT32 i;
+
+  if (Index->slot == NULL)
+    return;
+
+  i = pal_hash_probe(Index->slot, sizeof(PAL_HASH_SLOT_HDR), Index->mask, key);
+  if (Index->slot[i].Value != PPTT_INDEX_EMPTY)
+    return;
+
+  Index->slot[i].Key = key;
+  Index->slot[i].Value = value;
+}
 
 /**
   @brief  This API prints cache info table and cache entry indices for each pe.
@@ -78,13 +166,14 @@ pal_cache_dump_info_table(CACHE_INFO_TABLE *CacheTable, PE_INFO_TABLE *PeTable)
   @param  cache_type_struct Pointer to PPTT cache structure that needs to be parsed.
   @param  offset Offset of the cache structure in PPTT ACPI table.
   @param  is_private Flag indicating whether the cache is private.
+  @param  OffsetIndex Hash of PPTT offset to cache index, updated with the new entry.
   @return Index to the cache info entry where parsed info is stored.
 **/
 
 UINT32
 pal_cache_store_info(CACHE_INFO_TABLE *CacheTable,
                      EFI_ACPI_6_4_PPTT_STRUCTURE_CACHE *cache_type_struct,
-                     UINT32 offset, UINT32 is_private)
+                     UINT32 offset, UINT32 is_private, PPTT_INDEX *OffsetIndex)
 {
   CACHE_INFO_ENTRY *curr_entry;
   curr_entry = &(CacheTable->cache_info[CacheTable->num_of_cache]);
@@ -102,6 +191,7 @@ pal_cache_store_info(CACHE_INFO_TABLE *CacheTable,
   /* set default next level index to invalid */
   curr_entry->next_level_index = CACHE_INVALID_NEXT_LVL_IDX;
 
+  pal_pptt_index_add(OffsetIndex, offset, CacheTable->num_of_cache - 1);
   return CacheTable->num_of_cache - 1;
 }
 
@@ -111,14 +201,24 @@ pal_cache_store_info(CACHE_INFO_TABLE *CacheTable,
   @param  CacheTable Pointer to cache info table.
   @param  offset Offset of the cache structure in PPTT ACPI table.
   @param  found_index  pointer to a variable, to return index if cache info already present.
+  @param  OffsetIndex Hash of PPTT offset to cache index, the table is scanned if it is empty.
   @return 0 if cache info not present, 1 otherwise
 **/
 UINT32
-pal_cache_find(CACHE_INFO_TABLE *CacheTable, UINT32 offset, UINT32 *found_index)
+pal_cache_find(CACHE_INFO_TABLE *CacheTable, UINT32 offset, UINT32 *found_index,
+               PPTT_INDEX *OffsetIndex)
 {
   CACHE_INFO_ENTRY *curr_entry;
   UINT32 i;
 
+  if (OffsetIndex->slot != NULL) {
+    i = pal_pptt_index_find(OffsetIndex, offset);
+    if (i == PPTT_INDEX_EMPTY)
+      return 0;
+    *found_index = i;
+    return 1;
+  }
+
   curr_entry = CacheTable->cache_info;
   for (i = 0 ; i < CacheTable->num_of_cache ; i++) {
     /* match cache offset of the entry with input offset*/
@@ -133,26 +233,39 @@ pal_cache_find(CACHE_INFO_TABLE *CacheTable, UINT32 offset, UINT32 *found_index)
 
 /**
   @brief  This function stores level 1 cache info entry index(s) to pe info table.
+          The ACPI Processor UID of each GICC entry in MADT is unique, so only the first
+          PE with a matching UID is updated, by both the hash and the scan.
           Caller - pal_cache_create_info_table
   @param  PeTable Pointer to pe info table.
   @param  acpi_uid ACPI UID of the pe entry, to which index(s) to be stored.
   @param  cache_index index of the level 1 cache entry.
   @param  res_index private resource index of pe private cache.
+  @param  UidIndex Hash of ACPI UID to PE index, the table is scanned if it is empty.
   @return None
 **/
 VOID
 pal_cache_store_pe_res(PE_INFO_TABLE *PeTable, UINT32 acpi_uid,
-                       UINT32 cache_index, UINT32 res_index)
+                       UINT32 cache_index, UINT32 res_index, PPTT_INDEX *UidIndex)
 {
   PE_INFO_ENTRY *entry;
   entry = PeTable->pe_info;
   UINT32 i;
 
   if (res_index < MAX_L1_CACHE_RES) {
+    if (UidIndex->slot != NULL) {
+      i = pal_pptt_index_find(UidIndex, acpi_uid);
+      if (i != PPTT_INDEX_EMPTY) {
+        entry[i].level_1_res[res_index] = cache_index;
+        pal_pe_data_cache_ops_by_va((UINT64)&entry[i], CLEAN_AND_INVALIDATE);
+      }
+      return;
+    }
+
     for (i = 0 ; i < PeTable->header.num_of_pe; i++) {
       if (entry->acpi_proc_uid == acpi_uid) {
         entry->level_1_res[res_index] = cache_index;
         pal_pe_data_cache_ops_by_va((UINT64)entry, CLEAN_AND_INVALIDATE);
+        return;
       }
       entry++;
     }
@@ -162,6 +275,43 @@ pal_cache_store_pe_res(PE_INFO_TABLE *PeTable, UINT32 acpi_uid,
       L"\n  The input resource index is greater than supported value %d", MAX_L1_CACHE_RES);
 }
 
+/**
+  @brief  Build the lookup hashes used while parsing PPTT: PPTT offset -> cache index, sized
+          by the number of cache structures, and ACPI UID -> PE index from the PE info table.
+          Either hash is left empty if memory is not available, lookups then scan the tables.
+  @param  PpttHdr Pointer to PPTT ACPI table.
+  @param  PeTable Pointer to pe info table.
+  @param  OffsetIndex Hash of PPTT offset to cache index to initialize.
+  @param  UidIndex Hash of ACPI UID to PE index to initialize.
+  @return None
+**/
+STATIC VOID
+pal_cache_index_init(EFI_ACPI_6_4_PROCESSOR_PROPERTIES_TOPOLOGY_TABLE_HEADER *PpttHdr,
+                     PE_INFO_TABLE *PeTable, PPTT_INDEX *OffsetIndex, PPTT_INDEX *UidIndex)
+{
+  EFI_ACPI_6_4_PPTT_STRUCTURE_HEADER *pptt_struct, *pptt_end;
+  UINT32 num_cache = 0;
+  UINT32 i;
+
+  pptt_struct = ADD_PTR(EFI_ACPI_6_4_PPTT_STRUCTURE_HEADER, PpttHdr, PPTT_STRUCT_OFFSET);
+  pptt_end = ADD_PTR(EFI_ACPI_6_4_PPTT_STRUCTURE_HEADER, PpttHdr, PpttHdr->Header.Length);
+
+  while (pptt_struct < pptt_end) {
+    if (pptt_struct->Type == EFI_ACPI_6_4_PPTT_TYPE_CACHE)
+      num_cache++;
+    if (pptt_struct->Length == 0)
+      break;
+    pptt_struct = ADD_PTR(EFI_ACPI_6_4_PPTT_STRUCTURE_HEADER, pptt_struct, pptt_struct->Length);
+  }
+
+  pal_pptt_index_init(OffsetIndex, num_cache);
+
+  if (pal_pptt_index_init(UidIndex, PeTable->header.num_of_pe))
+    return;
+
+  for (i = 0; i < PeTable->header.num_of_pe; i++)
+    pal_pptt_index_add(UidIndex, PeTable->pe_info[i].acpi_proc_uid, i);
+}
 
 /**
   @brief  Parses ACPI PPTT table and populates the local cache info table.
@@ -182,6 +332,8 @@ pal_cache_create_info_table(CACHE_INFO_TABLE *CacheTable, PE_INFO_TABLE *PeTable
   UINT32 offset;
   UINT32 index;
   UINT32 next_index;
+  PPTT_INDEX OffsetIndex;
+  PPTT_INDEX UidIndex;
 
   if (CacheTable == NULL) {
     acs_print(ACS_PRINT_ERR, L" Unable to create cache info table, input pointer is NULL\n");
@@ -202,6 +354,8 @@ pal_cache_create_info_table(CACHE_INFO_TABLE *CacheTable, PE_INFO_TABLE *PeTable
                PpttHdr, TableLength);
   }
 
+  pal_cache_index_init(PpttHdr, PeTable, &OffsetIndex, &UidIndex);
+
 /* Pointer to first PPTT structure in PPTT ACPI table */
   pptt_struct = ADD_PTR(EFI_ACPI_6_4_PPTT_STRUCTURE_HEADER, PpttHdr, PPTT_STRUCT_OFFSET);
 
@@ -218,14 +372,15 @@ pal_cache_create_info_table(CACHE_INFO_TABLE *CacheTable, PE_INFO_TABLE *PeTable
         for (i = 0 ; i < pe_type_struct->NumberOfPrivateResources ; i++) {
           offset = *(ADD_PTR(UINT32, pe_type_struct, PPTT_PE_PRIV_RES_OFFSET + i*4));
           cache_type_struct =  ADD_PTR(EFI_ACPI_6_4_PPTT_STRUCTURE_CACHE, PpttHdr, offset);
-          index = pal_cache_store_info(CacheTable, cache_type_struct, offset, CACHE_TYPE_PRIVATE);
-          pal_cache_store_pe_res(PeTable, pe_type_struct->AcpiProcessorId, index, i);
+          index = pal_cache_store_info(CacheTable, cache_type_struct, offset, CACHE_TYPE_PRIVATE,
+                                       &OffsetIndex);
+          pal_cache_store_pe_res(PeTable, pe_type_struct->AcpiProcessorId, index, i, &UidIndex);
           /* parse next level(s) of current private PE cache  */
           while (cache_type_struct->NextLevelOfCache != 0) {
             offset = cache_type_struct->NextLevelOfCache;
             cache_type_struct =  ADD_PTR(EFI_ACPI_6_4_PPTT_STRUCTURE_CACHE, PpttHdr, offset);
             /* check if cache PPTT struct is already parsed*/
-            status = pal_cache_find(CacheTable, offset, &next_index);
+            status = pal_cache_find(CacheTable, offset, &next_index, &OffsetIndex);
             /* if cache structure is already parsed update the previous cache info with index
                of found cache entry in cache_info_table, else parse the cache structure*/
             if (status) {
@@ -235,7 +390,7 @@ pal_cache_create_info_table(CACHE_INFO_TABLE *CacheTable, PE_INFO_TABLE *PeTable
             else {
               CacheTable->cache_info[index].next_level_index = CacheTable->num_of_cache;
               index = pal_cache_store_info(CacheTable, cache_type_struct,
-                                           offset, CACHE_TYPE_PRIVATE);
+                                           offset, CACHE_TYPE_PRIVATE, &OffsetIndex);
             }
           }
 
@@ -256,7 +411,7 @@ pal_cache_create_info_table(CACHE_INFO_TABLE *CacheTable, PE_INFO_TABLE *PeTable
               if (cache_type_struct->Attributes.CacheType > 0x1 ||
                   cache_type_struct->Attributes.CacheType ==
                   CacheTable->cache_info[index].cache_type) {
-                status = pal_cache_find(CacheTable, offset, &next_index);
+                status = pal_cache_find(CacheTable, offset, &next_index, &OffsetIndex);
                 /* if cache structure is already parsed update the previous cache info with index
                    of found cache entry in cache_info_table, else parse the cache structure */
                 if (status) {
@@ -266,7 +421,7 @@ pal_cache_create_info_table(CACHE_INFO_TABLE *CacheTable, PE_INFO_TABLE *PeTable
                 else {
                   CacheTable->cache_info[index].next_level_index = CacheTable->num_of_cache;
                   index = pal_cache_store_info(CacheTable, cache_type_struct, offset,
-                                               CACHE_TYPE_SHARED);
+                                               CACHE_TYPE_SHARED, &OffsetIndex);
                 }
               }
             }
@@ -281,5 +436,8 @@ pal_cache_create_info_table(CACHE_INFO_TABLE *CacheTable, PE_INFO_TABLE *PeTable
     }
     pptt_struct = ADD_PTR(EFI_ACPI_6_4_PPTT_STRUCTURE_HEADER, pptt_struct, pptt_struct->Length);
   }
+
+  pal_pptt_index_free(&OffsetIndex);
+  pal_pptt_index_free(&UidIndex);
   pal_cache_dump_info_table(CacheTable, PeTable);
 }
@@ -140,6 +140,14 @@ VOID     pal_pe_data_cache_ops_by_va(UINT64 addr, UINT32 type);
 #define CLEAN                 0x2
 #define INVALIDATE            0x3
 
+/* Log file sink modes, see pal_log_set_mode */
+#define PAL_LOG_CONSOLE       0x0
+#define PAL_LOG_BUFFERED      0x1
+#define PAL_LOG_UNBUFFERED    0x2
+
+VOID     pal_log_flush(VOID);
+VOID     pal_log_set_mode(UINT32 mode);
+
 typedef struct {
   UINT32   gic_version;
   UINT32   num_gicd;
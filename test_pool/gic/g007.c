@@ -44,7 +44,6 @@ payload()
   /* Check COMMIRQ interrupt received   (x)    -- not feasible */
   /* Check PMBIRQ interrupt received    (x)    -- requires access to secure monitor */
 
-  uint32_t timeout = TIMEOUT_LARGE;
   uint32_t timer_expire_val = 100;
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
 
@@ -64,11 +63,7 @@ payload()
 
   val_timer_set_vir_el1(timer_expire_val);
 
-  while ((--timeout > 0) && (IS_RESULT_PENDING(val_get_status(index)))) {
-        ;
-  }
-
-  if (timeout == 0) {
+  if (!val_wait_for_status(index, VAL_WAIT_INTR_TIMEOUT_US)) {
     val_print(ACS_PRINT_ERR,
         "\n       EL0-Virtual timer interrupt not received on INTID: %d   ", intid);
     val_set_status(index, RESULT_FAIL(TEST_NUM, 3));
@@ -47,7 +47,6 @@ payload()
 {
 
     /*Check CNTHP interrupt received*/
-    uint32_t timeout = TIMEOUT_LARGE;
     uint64_t timer_expire_val = 100;
     uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
 
@@ -78,11 +77,7 @@ payload()
     }
 
     val_timer_set_phy_el2(timer_expire_val);
-    while ((--timeout > 0) && (IS_RESULT_PENDING(val_get_status(index)))) {
-        ;
-    }
-
-    if (timeout == 0) {
+    if (!val_wait_for_status(index, VAL_WAIT_INTR_TIMEOUT_US)) {
         val_print(ACS_PRINT_ERR,
             "\n       EL2-Phy timer interrupt not received on INTID: %d   ", intid);
         val_set_status(index, RESULT_FAIL(TEST_NUM, 4));
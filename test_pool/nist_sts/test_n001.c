@@ -29,7 +29,7 @@
 #define TEST_DESC  "NIST Statistical Test Suite           "
 
 #define BUFFER_SIZE     1000
-#define RND_FILE_SIZE   36428
+#define NIST_RNG_BLOCK_WORDS  1024  /* RNG words per block write to data.txt */
 #define REQ_OPEN_FILES  30
 #define ALL_NIST_TEST   0xFFFE
 #define NIST_SUITE_1    0xFE
@@ -51,6 +51,9 @@ static int acs_strnlen(const char *buffer, size_t max_len)
 /*Enabling all NIST test suites(test 1 - 15) by default */
 uint32_t test_select = ALL_NIST_TEST;
 
+/* Number of bitstreams handed to STS, may be overridden from the command line */
+uint32_t nist_num_streams = NIST_DEFAULT_STREAMS;
+
 static
 int32_t
 check_prerequisite_nist(void)
@@ -127,11 +130,11 @@ static
 int32_t
 create_random_file(void)
 {
-  uint32_t  buffer, status = ACS_STATUS_FAIL;
+  uint32_t  rng[NIST_RNG_BLOCK_WORDS];
+  uint8_t   block[NIST_RNG_BLOCK_WORDS * sizeof(uint32_t)];
+  uint32_t  status, words, chunk, i;
   FILE     *fp;
   char      str[] = "data.txt";
-  int32_t   i, j, k, noofr = RND_FILE_SIZE;
-  char      one = '1', zero = '0';
 
   fp = fopen(str, "wb");
   if (fp == NULL)
@@ -140,38 +143,51 @@ create_random_file(void)
       return ACS_STATUS_FAIL;
   }
 
-  for (i = 0; i < noofr; i++)
-  {
-      /* Get a 32-bit random number */
-      status = val_nist_generate_rng(&buffer);
+  /* STS reads exactly nist_num_streams sequences of NIST_STREAM_LEN bits */
+  words = nist_num_streams * (NIST_STREAM_LEN / 32);
+
+  while (words) {
+      chunk = (words < NIST_RNG_BLOCK_WORDS) ? words : NIST_RNG_BLOCK_WORDS;
+
+      status = val_nist_generate_rng_block(rng, chunk);
       if (status != ACS_STATUS_PASS) {
-	  val_print(ACS_PRINT_ERR, "\n       Random number generation failed", 0);
-	  fclose(fp);
+          val_print(ACS_PRINT_ERR, "\n       Random number generation failed", 0);
+          fclose(fp);
           return ACS_STATUS_FAIL;
       }
 
-      /* Convert decimal random number to binary value and
-       * write it as ASCII value in the file
+      /* STS binary mode consumes each byte MSB first, so store the words
+       * big-endian to keep the bit order of the old ASCII file.
        */
-      for (j = 31; j >= 0; j--) {
-          k = buffer >> j;
-          if (k & 1)
-	      fwrite(&one, sizeof(char), 1, fp);
-          else
-              fwrite(&zero, sizeof(char), 1, fp);
+      for (i = 0; i < chunk; i++) {
+          block[4 * i]     = (uint8_t)(rng[i] >> 24);
+          block[4 * i + 1] = (uint8_t)(rng[i] >> 16);
+          block[4 * i + 2] = (uint8_t)(rng[i] >> 8);
+          block[4 * i + 3] = (uint8_t)rng[i];
       }
+
+      if (fwrite(block, sizeof(uint32_t), chunk, fp) != chunk) {
+          val_print(ACS_PRINT_ERR, "\n       Unable to write random file", 0);
+          fclose(fp);
+          return ACS_STATUS_FAIL;
+      }
+
+      words -= chunk;
   }
 
   fclose(fp);
-  val_print(ACS_PRINT_INFO, "\nA random file with sequence of ASCII 0's and 1's created", 0);
+  val_print(ACS_PRINT_INFO, "\nA binary random file with %d bitstreams created",
+            nist_num_streams);
   return ACS_STATUS_PASS;
 }
+
 static
 void
 payload()
 {
   int32_t  status, i, argc = 2;
-  char    *argv[] = {"data.txt", "100000"};
+  char     stream_len[16];
+  char    *argv[] = {"data.txt", stream_len};
   char    *dirname = "experiments";
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
   uint32_t test_list[] = {NIST_SUITE_1, NIST_SUITE_2};
@@ -184,7 +200,12 @@ payload()
       val_print(ACS_PRINT_INFO, "\nSkipping test 8, 9 and 13 of NIST test suite", 0);
   }
 
-  /* Generate a Random file with binary ASCII values */
+  snprintf(stream_len, sizeof(stream_len), "%d", NIST_STREAM_LEN);
+
+  if ((nist_num_streams == 0) || (nist_num_streams > NIST_MAX_STREAMS))
+      nist_num_streams = NIST_DEFAULT_STREAMS;
+
+  /* Generate a Random file with binary bitstreams */
   status = create_random_file();
   if (status != ACS_STATUS_PASS) {
       val_set_status(index, RESULT_SKIP(TEST_NUM, 01));
@@ -49,7 +49,6 @@ payload1()
 {
   uint32_t intid;
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
-  uint64_t delay_loop = val_get_counter_frequency() * g_wakeup_timeout;
   uint64_t timer_expire_val = val_get_counter_frequency() * g_wakeup_timeout;
 
   intid = val_timer_get_info(TIMER_INFO_PHY_EL1_INTID, 0);
@@ -62,12 +61,11 @@ payload1()
   val_timer_set_phy_el1(timer_expire_val);
   val_power_enter_semantic(BSA_POWER_SEM_B);
 
-  /* Add a delay loop after WFI called in case PE needs some time to enter WFI state
+  /* Wait after WFI is called in case PE needs some time to enter WFI state
    * exit if test int comes
   */
-  while (delay_loop && (g_el1phy_int_received == 0)) {
-      delay_loop--;
-  }
+  val_wait_for_flag(&g_el1phy_int_received,
+                    (2 * g_wakeup_timeout + 1) * VAL_WAIT_US_PER_SEC);
 
   /* We are here means
    * 1. test interrupt has come (PASS) isr1
@@ -82,7 +80,6 @@ payload1()
       val_print(ACS_PRINT_DEBUG, "\n       PE wakeup by some other events/int", 0);
       val_set_status(index, RESULT_SKIP(TEST_NUM, 2));
   }
-  val_print(ACS_PRINT_INFO, "\n       delay loop remainig value %d", delay_loop);
   return;
 }
 
@@ -78,13 +78,20 @@ isr2()
   val_gic_end_of_interrupt(intid);
 }
 
+static
+uint32_t
+test_or_failsafe_received(void *arg)
+{
+  (void)arg;
+  return (g_el1vir_int_received || g_failsafe_int_rcvd);
+}
+
 static
 void
 payload2()
 {
   uint32_t intid;
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
-  uint64_t delay_loop = val_get_counter_frequency() * g_wakeup_timeout;
   uint64_t timer_expire_val = val_get_counter_frequency() * g_wakeup_timeout;
 
   intid = val_timer_get_info(TIMER_INFO_VIR_EL1_INTID, 0);
@@ -100,12 +107,11 @@ payload2()
   val_timer_set_vir_el1(timer_expire_val);
   val_power_enter_semantic(BSA_POWER_SEM_B);
 
-  /* Add a delay loop after WFI called in case PE needs some time to enter WFI state
+  /* Wait after WFI is called in case PE needs some time to enter WFI state
    * exit in case test or failsafe int is received
   */
-  while (delay_loop && (g_el1vir_int_received == 0) && (g_failsafe_int_rcvd == 0)) {
-      delay_loop--;
-  }
+  val_wait_until(test_or_failsafe_received, NULL,
+                 (2 * g_wakeup_timeout + 1) * VAL_WAIT_US_PER_SEC);
 
   /* We are here means
    * 1. test interrupt has come (PASS) isr2
@@ -123,7 +129,6 @@ payload2()
       val_print(ACS_PRINT_DEBUG,
                 "\n       PE wakeup by some other events/int or didn't enter WFI", 0);
   }
-  val_print(ACS_PRINT_INFO, "\n       delay loop remainig value %d", delay_loop);
   return;
 }
 
@@ -78,6 +78,14 @@ wakeup_clear_failsafe()
   val_timer_set_phy_el1(0);
 }
 
+static
+uint32_t
+test_or_failsafe_received(void *arg)
+{
+  (void)arg;
+  return (g_wd_int_received || g_failsafe_int_received);
+}
+
 static
 void
 payload4()
@@ -85,7 +93,6 @@ payload4()
   uint32_t status;
   uint32_t ns_wdg = 0;
   uint32_t intid;
-  uint32_t delay_loop;
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
   uint64_t timer_expire_val = 1 * g_wakeup_timeout;
 
@@ -128,13 +135,11 @@ payload4()
           }
           val_power_enter_semantic(BSA_POWER_SEM_B);
 
-          /* Add a delay loop after WFI called in case PE needs some time to enter WFI state
+          /* Wait after WFI is called in case PE needs some time to enter WFI state
            * exit in case test or failsafe int is received
           */
-          delay_loop = val_get_counter_frequency() * g_wakeup_timeout;
-	  while (delay_loop && (g_wd_int_received == 0) && (g_failsafe_int_received == 0)) {
-              delay_loop--;
-          }
+          val_wait_until(test_or_failsafe_received, NULL,
+                         (2 * g_wakeup_timeout + 1) * VAL_WAIT_US_PER_SEC);
 
           /* We are here means
            * 1. test interrupt has come (PASS) isr4
@@ -151,7 +156,6 @@ payload4()
     	      val_print(ACS_PRINT_DEBUG,
                         "\n       PE wakeup by some other events/int or didn't enter WFI", 0);
 	  }
-	  val_print(ACS_PRINT_DEBUG, "\n       delay loop remainig value %d", delay_loop);
       } else {
           val_print(ACS_PRINT_WARN, "\n       GIC Install Handler Failed...", 0);
           val_set_status(index, RESULT_FAIL(TEST_NUM, 3));
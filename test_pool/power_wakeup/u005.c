@@ -80,6 +80,14 @@ wakeup_clear_failsafe()
   val_timer_set_phy_el1(0);
 }
 
+static
+uint32_t
+test_or_failsafe_received(void *arg)
+{
+  (void)arg;
+  return (g_timer_int_rcvd || g_failsafe_int_rcvd);
+}
+
 static
 void
 payload5()
@@ -88,7 +96,6 @@ payload5()
   uint32_t ns_timer = 0;
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
   uint32_t intid;
-  uint64_t delay_loop;
   uint64_t cnt_base_n;
   uint64_t timer_expire_val = val_get_counter_frequency() * g_wakeup_timeout;
 
@@ -127,13 +134,11 @@ payload5()
           val_timer_set_system_timer((addr_t)cnt_base_n, timer_expire_val);
 	  val_power_enter_semantic(BSA_POWER_SEM_B);
 
-          /* Add a delay loop after WFI called in case PE needs some time to enter WFI state
+          /* Wait after WFI is called in case PE needs some time to enter WFI state
            * exit in case test or failsafe int is received
           */
-          delay_loop = val_get_counter_frequency() * g_wakeup_timeout;
-          while (delay_loop && (g_timer_int_rcvd == 0) && (g_failsafe_int_rcvd == 0)) {
-              delay_loop--;
-          }
+          val_wait_until(test_or_failsafe_received, NULL,
+                         (2 * g_wakeup_timeout + 1) * VAL_WAIT_US_PER_SEC);
 
           /* We are here means
            * 1. test interrupt has come (PASS) isr5
@@ -150,7 +155,6 @@ payload5()
               val_print(ACS_PRINT_DEBUG,
                         "\n       PE wakeup by some other events/int or didn't enter WFI", 0);
           }
-          val_print(ACS_PRINT_INFO, "\n       delay loop remainig value %d", delay_loop);
 	  return;
 
       } else{
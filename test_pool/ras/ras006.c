@@ -39,7 +39,8 @@ payload()
   uint64_t err_inj_addr;
   uint64_t prox_base_addr;
   uint64_t num_err_recs;
-  uint64_t err_rec_impl_bitmap;
+  uint64_t start_rec_index;
+  uint64_t err_rec_valid_bitmap;
   uint64_t err_rec_addrmode_bitmap;
   uint64_t data;
 
@@ -181,11 +182,11 @@ payload()
           /* wait loop to allow system to update RAS error records */
           val_ras_wait_timeout(1);
 
-          /* get error record implemented bitmap from RAS info table */
-          status = val_ras_get_info(RAS_INFO_ERR_REC_IMP, node_index, &err_rec_impl_bitmap);
+          /* get first error record index of current RAS node */
+          status = val_ras_get_info(RAS_INFO_START_INDEX, node_index, &start_rec_index);
           if (status) {
               val_print(ACS_PRINT_ERR,
-                        "\n       Couldn't get implemented rec bitmap for RAS node index: 0x%lx",
+                        "\n       Couldn't get start rec index for RAS node index: 0x%lx",
                         node_index);
               fail_cnt++;
               continue;
@@ -202,34 +203,28 @@ payload()
               continue;
           }
 
-          /* Iterate through each error record implemented and check if ERR<n>ADDR.AI bit is 0b0
-             if the address is the same as System Physical Address for the location,
-             and 0b1 otherwise.*/
-          for (err_rec_index = 0; err_rec_index < num_err_recs; err_rec_index++) {
-              /* check if error record is implemented for current node
-                 Bit[n] = 0b: Error record at index n is implemented.
-                 Bit[n] = 1b: Error record at index n is not implemented.
-                 If not implemented skip the error record */
-              if ((err_rec_impl_bitmap >> err_rec_index) & 0x1)
-                  continue;
-              /* since we have injected error in a memory location in current MC proximity domain
-                 space, one of the error record must have recorded address syndrome and
-                 ERR<n>STATUS AV, bit [31] & V, bit [30] must be valid for that error record */
+          /* since we have injected error in a memory location in current MC proximity domain
+             space, one of the error record must have recorded address syndrome and
+             ERR<n>STATUS AV, bit [31] & V, bit [30] must be valid for that error record.
+             Read ERR<n>STATUS of all implemented error records in one pass */
+          status = val_ras_scan_err_status(node_index, ERR_STATUS_V_MASK | ERR_STATUS_AV_MASK,
+                                           &err_rec_valid_bitmap);
+          if (status) {
+              val_print(ACS_PRINT_ERR,
+                          "\n       Couldn't read ERR<n>STATUS of %d error records for ",
+                          status);
+              val_print(ACS_PRINT_ERR,
+                          "RAS node index: 0x%lx",
+                          node_index);
+              fail_cnt += status;
+          }
 
-              /* if ERR<n>STATUS AV, bit [31] & V, bit [30] is invalid, continue with next
-                 error record */
-              data = val_ras_reg_read(node_index, RAS_ERR_STATUS, err_rec_index);
-              if (data == INVALID_RAS_REG_VAL) {
-                  val_print(ACS_PRINT_ERR,
-                              "\n       Couldn't read ERR<%d>STATUS register for ",
-                              err_rec_index);
-                  val_print(ACS_PRINT_ERR,
-                              "RAS node index: 0x%lx",
-                              node_index);
-                  fail_cnt++;
-                  continue;
-              }
-              if (!((data & ERR_STATUS_V_MASK) && (data & ERR_STATUS_AV_MASK)))
+          /* Iterate through each error record with address syndrome and check if
+             ERR<n>ADDR.AI bit is 0b0 if the address is the same as System Physical Address
+             for the location, and 0b1 otherwise.*/
+          for (err_rec_index = 0; (err_rec_index < num_err_recs) && (err_rec_index < 64);
+               err_rec_index++) {
+              if (!((err_rec_valid_bitmap >> err_rec_index) & 0x1))
                   continue;
 
               /* valid error record with address syndrome found */
@@ -242,11 +237,12 @@ payload()
               err_rec_addrmode = (err_rec_addrmode_bitmap >> err_rec_index) & 0x1;
 
               /* read ERR<n>ADDR.AI bit */
-              data = val_ras_reg_read(node_index, RAS_ERR_ADDR, err_rec_index);
+              data = val_ras_reg_read(node_index, RAS_ERR_ADDR,
+                                      start_rec_index + err_rec_index);
               if (data == INVALID_RAS_REG_VAL) {
                   val_print(ACS_PRINT_ERR,
-                              "\n       Couldn't read ERR<%d>STATUS register for ",
-                              err_rec_index);
+                              "\n       Couldn't read ERR<%d>ADDR register for ",
+                              start_rec_index + err_rec_index);
                   val_print(ACS_PRINT_ERR,
                               "RAS node index: 0x%lx",
                               node_index);
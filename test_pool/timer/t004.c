@@ -46,7 +46,6 @@ void
 payload()
 {
 
-  volatile uint32_t timeout;
   uint32_t timer_expire_val = TIMEOUT_MEDIUM;
   uint32_t status, ns_timer = 0;
   uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
@@ -65,7 +64,6 @@ payload()
           continue;    //Skip Secure Timer
 
       ns_timer++;
-      timeout = TIMEOUT_LARGE;
       val_set_status(index, RESULT_PENDING(TEST_NUM));     // Set the initial result to pending
 
       //Read CNTACR to determine whether access permission from NS state is permitted
@@ -103,10 +101,7 @@ payload()
       /* enable System timer */
       val_timer_set_system_timer((addr_t)cnt_base_n, timer_expire_val);
 
-      while ((--timeout > 0) && (IS_RESULT_PENDING(val_get_status(index))))
-      ;
-
-      if (timeout == 0) {
+      if (!val_wait_for_status(index, VAL_WAIT_INTR_TIMEOUT_US)) {
           val_print(ACS_PRINT_ERR, "\n       Sys timer interrupt not received on %d   ", intid);
           val_set_status(index, RESULT_FAIL(TEST_NUM, 3));
           return;
@@ -83,12 +83,20 @@ wakeup_clear_failsafe()
   val_timer_set_phy_el1(0);
 }
 
+static
+uint32_t
+ws0_or_failsafe_received(void *arg)
+{
+  (void)arg;
+  return (g_wd_int_received || g_failsafe_int_received);
+}
+
 static
 void
 payload()
 {
 
-    uint32_t status, timeout, ns_wdg = 0;
+    uint32_t status, ns_wdg = 0;
     uint64_t timer_expire_ticks = 1 * g_wakeup_timeout;
     uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
     wd_num = val_wd_get_info(0, WD_INFO_COUNT);
@@ -112,7 +120,6 @@ payload()
             continue;    /*Skip Secure watchdog*/
 
         ns_wdg++;
-        timeout = val_get_counter_frequency() * 2;
 
         int_id       = val_wd_get_info(wd_num, WD_INFO_GSIV);
         val_print(ACS_PRINT_DEBUG, "\n       WS0 Interrupt id  %d        ", int_id);
@@ -146,10 +153,8 @@ payload()
             return;
         }
 
-        timeout = val_get_counter_frequency() * 2;
-        while (timeout && (g_wd_int_received == 0) && (g_failsafe_int_received == 0)) {
-          timeout--;
-        }
+        /* The failsafe timer fires after 1.5 x g_wakeup_timeout seconds */
+        val_wait_until(ws0_or_failsafe_received, NULL, 2 * g_wakeup_timeout * VAL_WAIT_US_PER_SEC);
         wakeup_clear_failsafe();
 
         val_wd_set_ws0(wd_num, 0);
@@ -159,7 +164,7 @@ payload()
           return;
         }
 
-        if (timeout == 0) {
+        if (!g_wd_int_received) {
             val_print(ACS_PRINT_ERR, "\n       WS0 Interrupt not received on %d   ", int_id);
             val_set_status(index, RESULT_FAIL(TEST_NUM, 5));
             return;
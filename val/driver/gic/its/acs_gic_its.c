@@ -306,145 +306,193 @@ static void EnableITS(uint64_t GicItsBase)
   val_mmio_write(GicItsBase + ARM_GITS_CTLR, (value | ARM_GITS_CTLR_ENABLE));
 }
 
+/* Commands staged in the queue since CWRITER was last written */
+static uint32_t        *g_cmd_pending;
+
+static void ItsCmdqPublish(uint32_t its_index);
+static void PollTillCommandQueueDone(uint32_t its_index);
+
+/**
+  @brief   Stage one command at the shadow write pointer. Commands are only
+           made visible to the ITS by ItsCmdqPublish, a queue that fills up
+           is published and drained before more commands are staged.
+  @param   its_index  Index of the ITS
+  @param   dw0 - dw3  Command double words
+  @return  None
+**/
+static void
+WriteCmdQ(
+   uint32_t     its_index,
+   uint64_t     dw0,
+   uint64_t     dw1,
+   uint64_t     dw2,
+   uint64_t     dw3
+  )
+{
+    volatile uint64_t *cmd;
+
+    if (g_cmd_pending[its_index] == (ITS_CMDQ_NUM_CMDS - 1)) {
+        ItsCmdqPublish(its_index);
+        PollTillCommandQueueDone(its_index);
+    }
+
+    cmd = (volatile uint64_t *)g_gic_its_info->GicIts[its_index].CommandQBase +
+          g_cwriter_ptr[its_index];
+    cmd[0] = dw0;
+    cmd[1] = dw1;
+    cmd[2] = dw2;
+    cmd[3] = dw3;
+
+    g_cwriter_ptr[its_index] = (g_cwriter_ptr[its_index] + ITS_NEXT_CMD_PTR) % ITS_CMDQ_NUM_DW;
+    g_cmd_pending[its_index]++;
+}
+
 static void
 WriteCmdQMAPD(
    uint32_t     its_index,
-   uint64_t     *CMDQ_BASE,
    uint64_t     device_id,
    uint64_t     ITT_BASE,
    uint32_t     Size,
    uint64_t     Valid
   )
 {
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index]),
-                     (uint64_t)((device_id << ITS_CMD_SHIFT_DEVID) | ARM_ITS_CMD_MAPD));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 1), (uint64_t)(Size));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 2),
-                     (uint64_t)((Valid << ITS_CMD_SHIFT_VALID) | (ITT_BASE & ITT_PAR_MASK)));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 3), (uint64_t)(0x0));
-    g_cwriter_ptr[its_index] = g_cwriter_ptr[its_index] + ITS_NEXT_CMD_PTR;
+    WriteCmdQ(its_index,
+              (uint64_t)((device_id << ITS_CMD_SHIFT_DEVID) | ARM_ITS_CMD_MAPD),
+              (uint64_t)(Size),
+              (uint64_t)((Valid << ITS_CMD_SHIFT_VALID) | (ITT_BASE & ITT_PAR_MASK)),
+              0x0);
 }
 
 static void
 WriteCmdQMAPC(
    uint32_t     its_index,
-   uint64_t     *CMDQ_BASE,
    uint32_t     Clctn_ID,
    uint32_t     RDBase,
    uint64_t     Valid
   )
 {
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index]),
-                     (uint64_t)(ARM_ITS_CMD_MAPC));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 1), (uint64_t)(0x0));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 2),
-                     (uint64_t)((Valid << ITS_CMD_SHIFT_VALID) | RDBase | Clctn_ID));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 3), (uint64_t)(0x0));
-    g_cwriter_ptr[its_index] = g_cwriter_ptr[its_index] + ITS_NEXT_CMD_PTR;
+    WriteCmdQ(its_index,
+              (uint64_t)(ARM_ITS_CMD_MAPC),
+              0x0,
+              (uint64_t)((Valid << ITS_CMD_SHIFT_VALID) | RDBase | Clctn_ID),
+              0x0);
 }
 
 static void
 WriteCmdQMAPTI(
    uint32_t     its_index,
-   uint64_t     *CMDQ_BASE,
    uint64_t     device_id,
    uint32_t     int_id,
    uint32_t     Clctn_ID
   )
 {
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index]),
-                     (uint64_t)((device_id << ITS_CMD_SHIFT_DEVID) | ARM_ITS_CMD_MAPTI));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 1),
-                     ((uint64_t)(int_id-ARM_LPI_MINID) | ((uint64_t)int_id << 32)));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 2), (uint64_t)(Clctn_ID));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 3), (uint64_t)(0));
-    g_cwriter_ptr[its_index] = g_cwriter_ptr[its_index] + ITS_NEXT_CMD_PTR;
+    WriteCmdQ(its_index,
+              (uint64_t)((device_id << ITS_CMD_SHIFT_DEVID) | ARM_ITS_CMD_MAPTI),
+              ((uint64_t)(int_id-ARM_LPI_MINID) | ((uint64_t)int_id << 32)),
+              (uint64_t)(Clctn_ID),
+              0x0);
 }
 
 static void
 WriteCmdQINV(
    uint32_t     its_index,
-   uint64_t     *CMDQ_BASE,
    uint64_t     device_id,
    uint32_t     int_id
   )
 {
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index]),
-                     (uint64_t)((device_id << ITS_CMD_SHIFT_DEVID) | ARM_ITS_CMD_INV));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 1),
-                     (uint64_t)(int_id-ARM_LPI_MINID));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 2), (uint64_t)(0x0));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 3), (uint64_t)(0x0));
-    g_cwriter_ptr[its_index] = g_cwriter_ptr[its_index] + ITS_NEXT_CMD_PTR;
+    WriteCmdQ(its_index,
+              (uint64_t)((device_id << ITS_CMD_SHIFT_DEVID) | ARM_ITS_CMD_INV),
+              (uint64_t)(int_id-ARM_LPI_MINID),
+              0x0,
+              0x0);
 }
 
 static void
 WriteCmdQDISCARD(
    uint32_t     its_index,
-   uint64_t     *CMDQ_BASE,
    uint64_t     device_id,
    uint32_t     int_id
   )
 {
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index]),
-                     (uint64_t)((device_id << ITS_CMD_SHIFT_DEVID) | ARM_ITS_CMD_DISCARD));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 1),
-                     (uint64_t)(int_id-ARM_LPI_MINID));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 2), (uint64_t)(0x0));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 3), (uint64_t)(0x0));
-    g_cwriter_ptr[its_index] = g_cwriter_ptr[its_index] + ITS_NEXT_CMD_PTR;
+    WriteCmdQ(its_index,
+              (uint64_t)((device_id << ITS_CMD_SHIFT_DEVID) | ARM_ITS_CMD_DISCARD),
+              (uint64_t)(int_id-ARM_LPI_MINID),
+              0x0,
+              0x0);
 }
 
 
 static void
 WriteCmdQSYNC(
    uint32_t     its_index,
-   uint64_t     *CMDQ_BASE,
    uint32_t     RDBase
   )
 {
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index]),
-                     (uint64_t)(ARM_ITS_CMD_SYNC));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 1), (uint64_t)(0x0));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 2), (uint64_t)(RDBase));
-    val_mmio_write64((uint64_t)(CMDQ_BASE + g_cwriter_ptr[its_index] + 3), (uint64_t)(0x0));
-    g_cwriter_ptr[its_index] = g_cwriter_ptr[its_index] + ITS_NEXT_CMD_PTR;
+    WriteCmdQ(its_index,
+              (uint64_t)(ARM_ITS_CMD_SYNC),
+              0x0,
+              (uint64_t)(RDBase),
+              0x0);
 }
 
-static void PollTillCommandQueueDone(uint32_t its_index)
+/**
+  @brief   Make all staged commands visible to the ITS with one CWRITER write
+  @param   its_index  Index of the ITS
+  @return  None
+**/
+static void ItsCmdqPublish(uint32_t its_index)
+{
+  TestExecuteBarrier();
+
+  /* Update the CWRITER Register so that all the commands from Command queue gets executed.*/
+  val_mmio_write64((g_gic_its_info->GicIts[its_index].Base + ARM_GITS_CWRITER),
+                   (uint64_t)g_cwriter_ptr[its_index] * NUM_BYTES_IN_DW);
+  g_cmd_pending[its_index] = 0;
+}
+
+/**
+  @brief   Completion check for val_wait_until, CREADR has reached the
+           published write pointer. A stalled queue is told to retry.
+  @param   arg  Index of the ITS
+  @return  1 if the command queue is drained
+**/
+static uint32_t ItsCmdqDrained(void *arg)
 {
-  uint32_t    count;
+  uint32_t    its_index = (uint32_t)(uint64_t)arg;
   uint64_t    creadr_value;
-  uint64_t    stall_value;
   uint64_t    cwriter_value;
   uint64_t    ItsBase;
 
-  count = 0;
   ItsBase = g_gic_its_info->GicIts[its_index].Base;
-  cwriter_value = val_mmio_read64(ItsBase + ARM_GITS_CWRITER);
+  cwriter_value = (uint64_t)g_cwriter_ptr[its_index] * NUM_BYTES_IN_DW;
   creadr_value = val_mmio_read64(ItsBase + ARM_GITS_CREADR);
 
-  while (creadr_value != cwriter_value) {
-    /* Check Stall Value */
-    stall_value = creadr_value & ARM_GITS_CREADR_STALL;
-
-    if (stall_value) {
-      /* Retry */
-      val_mmio_write64((ItsBase + ARM_GITS_CWRITER),
-                  (cwriter_value | ARM_GITS_CWRITER_RETRY)
-                 );
-    }
-
-    count++;
-    if (count > WAIT_ITS_COMMAND_DONE) {
-      val_print(ACS_PRINT_ERR,
-                "\n       ITS : Command Queue READR not moving, Test may not pass", 0);
-      break;
-    }
+  if ((creadr_value & ARM_GITS_CREADR_OFFSET_MASK) == cwriter_value)
+    return 1;
 
-    creadr_value = val_mmio_read64(ItsBase + ARM_GITS_CREADR);
+  /* Check Stall Value */
+  if (creadr_value & ARM_GITS_CREADR_STALL) {
+    /* Retry */
+    val_mmio_write64((ItsBase + ARM_GITS_CWRITER),
+                (cwriter_value | ARM_GITS_CWRITER_RETRY)
+               );
   }
 
+  return 0;
+}
+
+/**
+  @brief   Wait for CREADR to reach the published write pointer. The PE
+           sleeps in WFE between reads, the ITS has no completion event so
+           the timer event stream wakes it.
+  @param   its_index  Index of the ITS
+  @return  None
+**/
+static void PollTillCommandQueueDone(uint32_t its_index)
+{
+  if (!val_wait_until(ItsCmdqDrained, (void *)(uint64_t)its_index, ITS_CMDQ_TIMEOUT_US))
+    val_print(ACS_PRINT_ERR,
+              "\n       ITS : Command Queue READR not moving, Test may not pass", 0);
 }
 
 static uint64_t GetRDBaseFormat(uint32_t its_index)
@@ -472,38 +520,42 @@ static uint64_t GetRDBaseFormat(uint32_t its_index)
 }
 
 
-void val_its_clear_lpi_map(uint32_t its_index, uint32_t device_id, uint32_t int_id)
+/**
+  @brief   Remove the mappings of num_ids consecutive LPIs of a device and
+           unmap the device, with one CWRITER update and one queue drain.
+  @param   its_index  Index of the ITS
+  @param   device_id  Device ID
+  @param   int_id     First LPI to unmap
+  @param   num_ids    Number of LPIs
+  @return  None
+**/
+void val_its_clear_lpi_map_range(uint32_t its_index, uint32_t device_id,
+                                 uint32_t int_id, uint32_t num_ids)
 {
-  uint64_t    value;
   uint64_t    RDBase;
-  uint64_t    ItsBase;
-  uint64_t    ItsCommandBase;
+  uint32_t    i;
 
   if (!g_its_setup_done)
     return;
 
-  ItsBase        = g_gic_its_info->GicIts[its_index].Base;
-  ItsCommandBase = g_gic_its_info->GicIts[its_index].CommandQBase;
-
-  /* Clear Config table for LPI=int_id */
-  ClearConfigTable(int_id);
+  /* Clear Config table for the LPIs */
+  for (i = 0; i < num_ids; i++)
+    ClearConfigTable(int_id + i);
 
   /* Get RDBase Depending on GITS_TYPER.PTA */
   RDBase = GetRDBaseFormat(its_index);
 
   /* Discard Mappings */
-  WriteCmdQDISCARD(its_index, (uint64_t *)(ItsCommandBase), device_id, int_id);
+  for (i = 0; i < num_ids; i++)
+    WriteCmdQDISCARD(its_index, device_id, int_id + i);
   /* Un Map Device using MAPD */
-  WriteCmdQMAPD(its_index, (uint64_t *)(ItsCommandBase), device_id,
+  WriteCmdQMAPD(its_index, device_id,
                 g_gic_its_info->GicIts[its_index].ITTBase,
                 0, 0 /*InValid*/);
   /* ITS SYNC Command */
-  WriteCmdQSYNC(its_index, (uint64_t *)(ItsCommandBase), RDBase);
+  WriteCmdQSYNC(its_index, RDBase);
 
-  TestExecuteBarrier();
-  /* Update the CWRITER Register so that all the commands from Command queue gets executed.*/
-  value = ((g_cwriter_ptr[its_index] * NUM_BYTES_IN_DW));
-  val_mmio_write64((ItsBase + ARM_GITS_CWRITER), value);
+  ItsCmdqPublish(its_index);
 
   /* Check CREADR value which ensures Command Queue is processed */
   PollTillCommandQueueDone(its_index);
@@ -511,22 +563,36 @@ void val_its_clear_lpi_map(uint32_t its_index, uint32_t device_id, uint32_t int_
 
 }
 
-void val_its_create_lpi_map(uint32_t its_index, uint32_t device_id,
-                            uint32_t int_id, uint32_t Priority)
+void val_its_clear_lpi_map(uint32_t its_index, uint32_t device_id, uint32_t int_id)
+{
+  val_its_clear_lpi_map_range(its_index, device_id, int_id, 1);
+}
+
+/**
+  @brief   Map num_ids consecutive LPIs of a device to collection 1, with one
+           CWRITER update and one queue drain for the whole range.
+  @param   its_index  Index of the ITS
+  @param   device_id  Device ID
+  @param   int_id     First LPI to map, event ID is int_id - ARM_LPI_MINID
+  @param   num_ids    Number of LPIs
+  @param   Priority   Priority programmed for each LPI
+  @return  None
+**/
+void val_its_create_lpi_map_range(uint32_t its_index, uint32_t device_id,
+                                  uint32_t int_id, uint32_t num_ids, uint32_t Priority)
 {
-  uint64_t    value;
   uint64_t    RDBase;
   uint64_t    ItsBase;
-  uint64_t    ItsCommandBase;
+  uint32_t    i;
 
   if (!g_its_setup_done)
     return;
 
   ItsBase        = g_gic_its_info->GicIts[its_index].Base;
-  ItsCommandBase = g_gic_its_info->GicIts[its_index].CommandQBase;
 
-  /* Set Config table with enable the LPI = int_id, Priority. */
-  SetConfigTable(int_id, Priority);
+  /* Set Config table with enable the LPIs, Priority. */
+  for (i = 0; i < num_ids; i++)
+    SetConfigTable(int_id + i, Priority);
 
   /* Enable Redistributor */
   EnableLPIsRD(g_gic_its_info->GicRdBase);
@@ -538,24 +604,23 @@ void val_its_create_lpi_map(uint32_t its_index, uint32_t device_id,
   RDBase = GetRDBaseFormat(its_index);
 
   /* Map Device using MAPD */
-  WriteCmdQMAPD(its_index, (uint64_t *)(ItsCommandBase), device_id,
+  WriteCmdQMAPD(its_index, device_id,
                 g_gic_its_info->GicIts[its_index].ITTBase,
                 g_gic_its_info->GicIts[its_index].IDBits, 0x1 /*Valid*/);
   /* Map Collection using MAPC */
-  WriteCmdQMAPC(its_index, (uint64_t *)(ItsCommandBase),
-                0x1 /*Clctn_ID*/, RDBase, 0x1 /*Valid*/);
-  /* Map Interrupt using MAPI */
-  WriteCmdQMAPTI(its_index, (uint64_t *)(ItsCommandBase), device_id, int_id, 0x1 /*Clctn_ID*/);
-  /* Invalid Entry */
-  WriteCmdQINV(its_index, (uint64_t *)(ItsCommandBase), device_id, int_id);
-  /* ITS SYNC Command */
-  WriteCmdQSYNC(its_index, (uint64_t *)(ItsCommandBase), RDBase);
+  WriteCmdQMAPC(its_index, 0x1 /*Clctn_ID*/, RDBase, 0x1 /*Valid*/);
 
-  TestExecuteBarrier();
+  for (i = 0; i < num_ids; i++) {
+    /* Map Interrupt using MAPI */
+    WriteCmdQMAPTI(its_index, device_id, int_id + i, 0x1 /*Clctn_ID*/);
+    /* Invalid Entry */
+    WriteCmdQINV(its_index, device_id, int_id + i);
+  }
 
-  /* Update the CWRITER Register so that all the commands from Command queue gets executed.*/
-  value = ((g_cwriter_ptr[its_index] * NUM_BYTES_IN_DW));
-  val_mmio_write64((ItsBase + ARM_GITS_CWRITER), value);
+  /* ITS SYNC Command */
+  WriteCmdQSYNC(its_index, RDBase);
+
+  ItsCmdqPublish(its_index);
 
   /* Check CREADR value which ensures Command Queue is processed */
   PollTillCommandQueueDone(its_index);
@@ -563,6 +628,12 @@ void val_its_create_lpi_map(uint32_t its_index, uint32_t device_id,
 
 }
 
+void val_its_create_lpi_map(uint32_t its_index, uint32_t device_id,
+                            uint32_t int_id, uint32_t Priority)
+{
+  val_its_create_lpi_map_range(its_index, device_id, int_id, 1, Priority);
+}
+
 
 uint32_t val_its_get_max_lpi(void)
 {
@@ -636,8 +707,18 @@ uint32_t val_its_init(void)
     return 0;
   }
 
-  for (index = 0; index < g_gic_its_info->GicNumIts; index++)
+  g_cmd_pending = (uint32_t *)pal_aligned_alloc(MEM_ALIGN_4K,
+                                                sizeof(uint32_t) * (g_gic_its_info->GicNumIts));
+
+  if (g_cmd_pending == NULL) {
+    val_print(ACS_PRINT_ERR, "ITS : Could Not Allocate Memory CmdQ state. Test may not pass.\n", 0);
+    return 0;
+  }
+
+  for (index = 0; index < g_gic_its_info->GicNumIts; index++) {
     g_cwriter_ptr[index] = 0;
+    g_cmd_pending[index] = 0;
+  }
 
   for (index = 0; index < g_gic_its_info->GicNumIts; index++)
   {
@@ -39,7 +39,6 @@
 #define ARM_LPI_MIN_IDBITS  14
 #define ARM_LPI_MAX_IDBITS  31
 
-#define WAIT_ITS_COMMAND_DONE   10000
 
 /* GICv3 specific registers */
 
@@ -130,6 +129,7 @@
 
 /* GITS_CREADR Bits */
 #define ARM_GITS_CREADR_STALL       (1 << 0)
+#define ARM_GITS_CREADR_OFFSET_MASK (0xFFFFFull << 5)
 
 /* GITS_CWRITER Bits */
 #define ARM_GITS_CWRITER_RETRY      (1 << 0)
@@ -184,6 +184,10 @@
 #define ITS_NEXT_CMD_PTR    4
 #define NUM_BYTES_IN_DW     8
 
+#define ITS_CMDQ_NUM_DW     ((NUM_PAGES_8 * SIZE_4KB) / NUM_BYTES_IN_DW)
+#define ITS_CMDQ_NUM_CMDS   (ITS_CMDQ_NUM_DW / ITS_NEXT_CMD_PTR)
+#define ITS_CMDQ_TIMEOUT_US 100000  /* Command queue drain, see val_wait_until */
+
 uint32_t ArmGicRedistributorConfigurationForLPI(uint64_t rd_base);
 
 void ClearConfigTable(uint32_t int_id);
@@ -197,6 +201,10 @@ void EnableLPIsRD(uint64_t rd_base);
 void val_its_create_lpi_map(uint32_t its_index, uint32_t device_id,
                             uint32_t int_id, uint32_t Priority);
 void val_its_clear_lpi_map(uint32_t its_index, uint32_t device_id, uint32_t int_id);
+void val_its_create_lpi_map_range(uint32_t its_index, uint32_t device_id,
+                                  uint32_t int_id, uint32_t num_ids, uint32_t Priority);
+void val_its_clear_lpi_map_range(uint32_t its_index, uint32_t device_id,
+                                 uint32_t int_id, uint32_t num_ids);
 
 uint64_t val_its_get_translater_addr(uint32_t its_index);
 uint32_t val_its_get_max_lpi(void);
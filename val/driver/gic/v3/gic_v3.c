@@ -60,53 +60,6 @@ v3_read_gicr_typer(void)
 }
 
 
-/**
-  @brief  derives current pe rd base
-  @param  rd base
-  @param  rd base length
-  @return pe rd base
-**/
-static uint64_t
-CurrentCpuRDBase(uint64_t mGicRedistributorBase, uint32_t length)
-{
-  uint64_t     Affinity, CpuAffinity;
-  uint64_t     GicRedistributorGranularity;
-  uint64_t     GicCpuRedistributorBase;
-  uint64_t     Mpidr;
-
-  Mpidr = ArmReadMpidr();
-
-  CpuAffinity = (Mpidr & (PE_AFF0 | PE_AFF1 | PE_AFF2)) | ((Mpidr & PE_AFF3) >> 8);
-
-  GicRedistributorGranularity = GICR_CTLR_FRAME_SIZE + GICR_SGI_PPI_FRAME_SIZE;
-
-  GicCpuRedistributorBase = mGicRedistributorBase;
-
-  /* If information is present in GICC Structure */
-  if (length == 0)
-  {
-      Affinity = (val_mmio_read64(GicCpuRedistributorBase + GICR_TYPER) & GICR_TYPER_AFF) >> 32;
-      if (Affinity == CpuAffinity) {
-        return GicCpuRedistributorBase;
-      }
-      return 0;
-  }
-
-  /* If information is present in GICR Structure */
-  while (GicCpuRedistributorBase < (mGicRedistributorBase + length))
-  {
-    Affinity = (val_mmio_read64(GicCpuRedistributorBase + GICR_TYPER) & GICR_TYPER_AFF) >> 32;
-    if (Affinity == CpuAffinity) {
-      return GicCpuRedistributorBase;
-    }
-
-    /* Move to the next GIC Redistributor frame */
-    GicCpuRedistributorBase += GicRedistributorGranularity;
-  }
-
-  return 0;
-}
-
 /**
   @brief  Marks primary PE as online
   @param  none
@@ -115,13 +68,10 @@ CurrentCpuRDBase(uint64_t mGicRedistributorBase, uint32_t length)
 static void
 WakeUpRD(void)
 {
-  uint32_t                rdbase_len;
-  uint64_t                rd_base;
   uint64_t                cpuRd_base;
   uint32_t                tmp;
 
-  rd_base = val_get_gicr_base(&rdbase_len, 0);
-  cpuRd_base = CurrentCpuRDBase(rd_base, rdbase_len);
+  cpuRd_base = v3_get_pe_gicr_base();
   if (cpuRd_base == 0) {
     return;
   }
@@ -136,18 +86,13 @@ WakeUpRD(void)
 }
 
 /**
-  @brief  derives current pe rd base
+  @brief  derives current pe rd base from the map built with the GIC info table
   @param  none
   @return pe rd base
 **/
 uint64_t v3_get_pe_gicr_base(void)
 {
-  uint32_t                rdbase_len;
-  uint64_t                rd_base;
-
-  rd_base = val_get_gicr_base(&rdbase_len, 0);
-
-  return CurrentCpuRDBase(rd_base, rdbase_len);
+  return val_gic_get_pe_rdbase(ArmReadMpidr());
 }
 
 /**
@@ -182,8 +127,6 @@ v3_DisableInterruptSource(uint32_t int_id)
 {
   uint32_t                regOffset;
   uint32_t                regShift;
-  uint32_t                rdbase_len;
-  uint64_t                rd_base;
   uint64_t                cpuRd_base;
 
   if (v3_is_extended_spi(int_id) || v3_is_extended_ppi(int_id)) {
@@ -198,8 +141,7 @@ v3_DisableInterruptSource(uint32_t int_id)
   if (IsSpi(int_id)) {
       val_mmio_write(val_get_gicd_base() + GICD_ICENABLER + (4 * regOffset), 1 << regShift);
   } else {
-    rd_base = val_get_gicr_base(&rdbase_len, 0);
-    cpuRd_base = CurrentCpuRDBase(rd_base, rdbase_len);
+    cpuRd_base = v3_get_pe_gicr_base();
     if (cpuRd_base == 0) {
       return;
     }
@@ -218,8 +160,6 @@ v3_EnableInterruptSource(uint32_t int_id)
 {
   uint32_t                regOffset;
   uint32_t                regShift;
-  uint32_t                rdbase_len;
-  uint64_t                rd_base;
   uint64_t                cpuRd_base;
 
   if (v3_is_extended_spi(int_id) || v3_is_extended_ppi(int_id)) {
@@ -233,8 +173,7 @@ v3_EnableInterruptSource(uint32_t int_id)
   if (IsSpi(int_id)) {
       val_mmio_write(val_get_gicd_base() + GICD_ISENABLER + (4 * regOffset), 1 << regShift);
   } else {
-    rd_base = val_get_gicr_base(&rdbase_len, 0);
-    cpuRd_base = CurrentCpuRDBase(rd_base, rdbase_len);
+    cpuRd_base = v3_get_pe_gicr_base();
     if (cpuRd_base == 0) {
       return;
     }
@@ -254,8 +193,6 @@ v3_SetInterruptPriority(uint32_t int_id, uint32_t priority)
 {
   uint32_t                regOffset;
   uint32_t                regShift;
-  uint32_t                rdbase_len;
-  uint64_t                rd_base;
   uint64_t                cpuRd_base;
 
   if (v3_is_extended_spi(int_id) || v3_is_extended_ppi(int_id)) {
@@ -272,8 +209,7 @@ v3_SetInterruptPriority(uint32_t int_id, uint32_t priority)
                     (val_mmio_read(val_get_gicd_base() + GICD_IPRIORITYR + (4 * regOffset)) &
                      ~(0xff << regShift)) | priority << regShift);
   } else {
-    rd_base = val_get_gicr_base(&rdbase_len, 0);
-    cpuRd_base = CurrentCpuRDBase(rd_base, rdbase_len);
+    cpuRd_base = v3_get_pe_gicr_base();
     if (cpuRd_base == 0) {
       return;
     }
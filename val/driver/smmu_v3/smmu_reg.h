@@ -42,6 +42,7 @@ BITFIELD_DECL(uint32_t, IDR0_TTF, 3, 2)
 #define IDR0_S1P (1 << 1)
 #define IDR0_S2P (1 << 0)
 #define IDR0_MSI (1 << 13)
+#define IDR0_SEV (1 << 14)
 
 #define SMMU_IDR1_OFFSET 0x4
 #define IDR1_TABLES_PRESET (1 << 30)
@@ -197,8 +198,13 @@ BITFIELD_DECL(uint64_t, STRTAB_STE_3_S2TTB, 51, 4)
 BITFIELD_DECL(uint64_t, CMDQ_0_OP, 7, 0)
 BITFIELD_DECL(uint64_t, CMDQ_CFGI_1_RANGE, 4, 0)
 #define CMDQ_CFGI_1_ALL_STES 31
+BITFIELD_DECL(uint64_t, CMDQ_SYNC_0_CS, 13, 12)
+#define CMDQ_SYNC_0_CS_NONE 0
+#define CMDQ_SYNC_0_CS_SEV  2
 
-#define SMMU_CMDQ_POLL_TIMEOUT 0x100000
+#define SMMU_CMDQ_POLL_TIMEOUT 0x100000  /* CONS polls, Linux driver */
+#define SMMU_CMDQ_TIMEOUT_US   100000    /* CMDQ drain timeout, see val_wait_until */
+#define SMMU_CMDQ_BATCH_MAX    16  /* Commands published per PROD update */
 
 #define CDTAB_SPLIT             10
 #define CDTAB_L2_ENTRY_COUNT    (1 << CDTAB_SPLIT)
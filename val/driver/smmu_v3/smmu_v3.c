@@ -77,79 +77,169 @@ static int smmu_cmdq_build_cmd(uint64_t *cmd, uint8_t opcode)
     return 0;
 }
 
-static int smmu_cmdq_write_cmd(smmu_dev_t *smmu, uint64_t *cmd)
+static uint32_t smmu_queue_space(smmu_queue_t *q)
 {
+    uint32_t used = (q->prod - q->cons) & ((0x1ul << (q->log2nent + 1)) - 1);
+
+    return (0x1ul << q->log2nent) - used;
+}
+
+/* Argument of smmu_cmdq_has_space, wait for room for num commands, 0 to drain */
+typedef struct {
+    smmu_dev_t *smmu;
+    uint32_t    num;
+} smmu_cmdq_wait_t;
+
+/**
+  @brief Refresh the CONS shadow and check for room in the command queue
+  @param arg - smmu_cmdq_wait_t
+  @return 1 if there is room for num commands, or the queue is empty for 0
+**/
+static uint32_t smmu_cmdq_has_space(void *arg)
+{
+    smmu_cmdq_wait_t *wait = (smmu_cmdq_wait_t *)arg;
+    smmu_cmd_queue_t *cmdq = &wait->smmu->cmdq;
+
+    cmdq->queue.cons = val_mmio_read((uint64_t)cmdq->cons_reg);
+    if (wait->num == 0)
+        return smmu_queue_empty(&cmdq->queue);
+
+    return (smmu_queue_space(&cmdq->queue) >= wait->num);
+}
+
+/**
+  @brief Wait for the command queue to have room or to drain. Outside the
+         Linux driver this sleeps in WFE until a deadline on the generic
+         counter, CMD_SYNC with CS=SEV wakes it as soon as the SMMU is done.
+  @param wait - Queue and condition to wait for
+  @return 1 if the condition holds, 0 on timeout
+**/
+static uint32_t smmu_cmdq_wait(smmu_cmdq_wait_t *wait)
+{
+#ifndef TARGET_LINUX
+    return val_wait_until(smmu_cmdq_has_space, (void *)wait, SMMU_CMDQ_TIMEOUT_US);
+#else
     uint32_t timeout = SMMU_CMDQ_POLL_TIMEOUT;
-    int ret = 0, i;
-    uint64_t *cmd_dst;
-    smmu_cmd_queue_t *cmdq = &smmu->cmdq;
-    smmu_queue_t
-        queue =
-            {
-                .log2nent = cmdq->queue.log2nent,
-            };
 
-    while (smmu_queue_full(&cmdq->queue) && timeout) {
-        timeout--;
+    while (timeout--) {
+        if (smmu_cmdq_has_space(wait))
+            return 1;
     }
+    return 0;
+#endif
+}
+
+/**
+  @brief Copy staged commands into the CMDQ and publish them with a single
+         PROD update. The driver is the only producer, so PROD is tracked in
+         cmdq->queue.prod and CONS is only read while waiting for space.
+  @param smmu - SMMU device
+  @param cmds - Commands, CMDQ_DWORDS_PER_ENT dwords each
+  @param num  - Number of commands
+  @return 0 on success, -1 if the queue did not drain in time
+**/
+static int smmu_cmdq_publish(smmu_dev_t *smmu, uint64_t *cmds, uint32_t num)
+{
+    uint32_t index_mask, i, j;
+    uint64_t *cmd_dst;
+    smmu_cmd_queue_t *cmdq = &smmu->cmdq;
+    smmu_cmdq_wait_t wait = { smmu, num };
 
-    if (!timeout) {
+    if (!smmu_cmdq_wait(&wait)) {
         val_print(ACS_PRINT_ERR, "\n       SMMU CMD queue is full     ", 0);
         return -1;
     }
 
-    queue.prod = val_mmio_read((uint64_t)cmdq->prod_reg);
-    cmd_dst = (uint64_t *)(cmdq->base + ((queue.prod & ((0x1ull << queue.log2nent) - 1)) * (cmdq->entry_size)));
-    for (i = 0; i < CMDQ_DWORDS_PER_ENT; ++i)
-        cmd_dst[i] = cmd[i];
-    queue.prod = smmu_inc_prod(&queue);
+    index_mask = (0x1ul << cmdq->queue.log2nent) - 1;
+    for (i = 0; i < num; i++) {
+        cmd_dst = (uint64_t *)(cmdq->base + ((cmdq->queue.prod & index_mask) * cmdq->entry_size));
+        for (j = 0; j < CMDQ_DWORDS_PER_ENT; ++j)
+            cmd_dst[j] = cmds[i * CMDQ_DWORDS_PER_ENT + j];
+        cmdq->queue.prod = smmu_inc_prod(&cmdq->queue);
+    }
 
 #ifndef TARGET_LINUX
     ArmExecuteMemoryBarrier();
 #endif
-    val_mmio_write((uint64_t)cmdq->prod_reg, queue.prod);
+    val_mmio_write((uint64_t)cmdq->prod_reg, cmdq->queue.prod);
 
-    return ret;
+    return 0;
 }
 
-static int smmu_cmdq_issue_cmd(smmu_dev_t *smmu,
-                   uint8_t opcode)
+/**
+  @brief Stage a command in the batch. A full batch is published without
+         waiting for it to be consumed.
+  @param smmu   - SMMU device
+  @param batch  - Batch to add the command to
+  @param opcode - Command opcode
+  @return 0 on success, -1 on failure
+**/
+static int smmu_cmdq_batch_add(smmu_dev_t *smmu, smmu_cmdq_batch_t *batch, uint8_t opcode)
 {
-    uint64_t cmd[CMDQ_DWORDS_PER_ENT];
+    if (batch->num == SMMU_CMDQ_BATCH_MAX) {
+        if (smmu_cmdq_publish(smmu, batch->cmds, batch->num))
+            return -1;
+        batch->num = 0;
+    }
 
-    if (smmu_cmdq_build_cmd(cmd, opcode)) {
+    if (smmu_cmdq_build_cmd(&batch->cmds[batch->num * CMDQ_DWORDS_PER_ENT], opcode))
         return -1;
-    }
 
-    return smmu_cmdq_write_cmd(smmu, cmd);
+    batch->num++;
+    return 0;
 }
 
-static void smmu_cmdq_poll_until_consumed(smmu_dev_t *smmu)
+/**
+  @brief Wait until the SMMU has consumed every published command
+  @param smmu - SMMU device
+  @return 0 on success, -1 on timeout
+**/
+static int smmu_cmdq_wait_for_sync(smmu_dev_t *smmu)
 {
-    uint32_t timeout = SMMU_CMDQ_POLL_TIMEOUT;
     smmu_cmd_queue_t *cmdq = &smmu->cmdq;
-    smmu_queue_t queue = {
-                .log2nent = smmu->cmdq.queue.log2nent,
-                .prod = val_mmio_read((uint64_t)smmu->cmdq.prod_reg),
-                .cons = val_mmio_read((uint64_t)smmu->cmdq.cons_reg)
-            };
-
-    while (timeout > 0) {
-        if (smmu_queue_empty(&queue))
-            break;
-        queue.cons = val_mmio_read((uint64_t)cmdq->cons_reg);
-        timeout--;
-    }
+    smmu_cmdq_wait_t wait = { smmu, 0 };
 
-    if (!timeout) {
-        val_print(ACS_PRINT_ERR, "\n       CMDQ poll timeout at 0x%08x", queue.prod);
+    smmu_cmdq_wait(&wait);
+
+    if (!smmu_queue_empty(&cmdq->queue)) {
+        val_print(ACS_PRINT_ERR, "\n       CMDQ poll timeout at 0x%08x", cmdq->queue.prod);
         val_print(ACS_PRINT_ERR, "\n       prod_reg = 0x%08x,",
 val_mmio_read((uint64_t)smmu->cmdq.prod_reg));
         val_print(ACS_PRINT_ERR, "\n       cons_reg = 0x%08x",
 val_mmio_read((uint64_t)smmu->cmdq.cons_reg));
         val_print(ACS_PRINT_ERR, "\n       gerror   = 0x%08x     ",
 val_mmio_read(smmu->base + SMMU_GERROR_OFFSET));
+        return -1;
     }
+
+    return 0;
+}
+
+/**
+  @brief Append CMD_SYNC to the batch, publish it with one PROD update and
+         wait for the SMMU to complete it.
+  @param smmu  - SMMU device
+  @param batch - Staged commands, empty on return
+  @return 0 on success, -1 on failure
+**/
+static int smmu_cmdq_batch_submit(smmu_dev_t *smmu, smmu_cmdq_batch_t *batch)
+{
+    int ret;
+
+    ret = smmu_cmdq_batch_add(smmu, batch, CMDQ_OP_CMD_SYNC);
+    if (ret)
+        return ret;
+
+    batch->cmds[(batch->num - 1) * CMDQ_DWORDS_PER_ENT] |=
+        BITFIELD_SET(CMDQ_SYNC_0_CS, smmu->supported.sev ? CMDQ_SYNC_0_CS_SEV :
+                                                           CMDQ_SYNC_0_CS_NONE);
+
+    ret = smmu_cmdq_publish(smmu, batch->cmds, batch->num);
+    batch->num = 0;
+    if (ret)
+        return ret;
+
+    return smmu_cmdq_wait_for_sync(smmu);
 }
 
 static void smmu_strtab_write_ste(smmu_master_t *master, uint64_t *ste)
@@ -655,16 +745,18 @@ static int smmu_dev_disable(smmu_dev_t *smmu)
 
 static void smmu_tlbi_cfgi(smmu_dev_t *smmu)
 {
+    smmu_cmdq_batch_t batch;
+
+    batch.num = 0;
+
     /* Invalidate any cached configuration */
-    smmu_cmdq_issue_cmd(smmu, CMDQ_OP_CFGI_ALL);
+    smmu_cmdq_batch_add(smmu, &batch, CMDQ_OP_CFGI_ALL);
     if (smmu->supported.hyp) {
-        smmu_cmdq_issue_cmd(smmu, CMDQ_OP_TLBI_EL2_ALL);
+        smmu_cmdq_batch_add(smmu, &batch, CMDQ_OP_TLBI_EL2_ALL);
     }
 
-    smmu_cmdq_issue_cmd(smmu, CMDQ_OP_TLBI_NSNH_ALL);
-    smmu_cmdq_issue_cmd(smmu, CMDQ_OP_CMD_SYNC);
-
-    smmu_cmdq_poll_until_consumed(smmu);
+    smmu_cmdq_batch_add(smmu, &batch, CMDQ_OP_TLBI_NSNH_ALL);
+    smmu_cmdq_batch_submit(smmu, &batch);
 }
 
 static int smmu_reset(smmu_dev_t *smmu)
@@ -691,6 +783,7 @@ static int smmu_reset(smmu_dev_t *smmu)
             smmu->strtab_cfg.strtab_base_cfg);
 
     val_mmio_write64(smmu->base + SMMU_CMDQ_BASE_OFFSET, smmu->cmdq.queue_base);
+    smmu->cmdq.queue.prod = smmu->cmdq.queue.cons = 0;
     val_mmio_write(smmu->base + SMMU_CMDQ_PROD_OFFSET, smmu->cmdq.queue.prod);
     val_mmio_write(smmu->base + SMMU_CMDQ_CONS_OFFSET, smmu->cmdq.queue.cons);
 
@@ -807,6 +900,9 @@ static uint32_t smmu_probe(smmu_dev_t *smmu)
     if (data & IDR0_S2P)
         smmu->supported.s2p = 1;
 
+    if (data & IDR0_SEV)
+        smmu->supported.sev = 1;
+
     if (!(data & (IDR0_S1P | IDR0_S2P))) {
         val_print(ACS_PRINT_ERR, "  no translation support!\n ", 0);
         return 0;
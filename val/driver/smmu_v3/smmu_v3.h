@@ -58,6 +58,12 @@ typedef struct {
     uint32_t *cons_reg;
 } smmu_cmd_queue_t;
 
+/* Commands staged in memory and published to the CMDQ together */
+typedef struct {
+    uint64_t cmds[SMMU_CMDQ_BATCH_MAX * CMDQ_DWORDS_PER_ENT];
+    uint32_t num;
+} smmu_cmdq_batch_t;
+
 typedef struct {
     smmu_queue_t queue;
     void    *base_ptr;
@@ -138,6 +144,7 @@ typedef struct {
            uint32_t s1p:1;
            uint32_t s2p:1;
            uint32_t msi:1;
+           uint32_t sev:1;
         };
         uint32_t bitmap;
     } supported;
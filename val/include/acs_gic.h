@@ -66,6 +66,15 @@ typedef struct {
   MSI_FRAME_ENTRY   msi_info[];
 } GICv2m_MSI_FRAME_INFO;
 
+/**
+  @brief  Redistributor of one PE, keyed by GICR_TYPER.Affinity_Value
+**/
+typedef struct {
+  uint32_t affinity;
+  uint32_t reserved;
+  uint64_t rd_base;
+} GIC_RDBASE_ENTRY;
+
 addr_t val_get_gicd_base(void);
 addr_t val_gic_get_pe_rdbase(uint64_t mpidr);
 addr_t val_get_gicr_base(uint32_t *rdbase_len, uint32_t gicr_rd_index);
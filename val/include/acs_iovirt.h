@@ -33,6 +33,45 @@ typedef enum {
   PMCG_NODE_SMMU_BASE
 } PMCG_INFO_e;
 
+/* One IORT ID mapping flattened into the sorted ID index. Entries are
+ * ordered by (key, input_base); max_end is the largest input_end of this
+ * entry and all earlier entries with the same key, which bounds the
+ * backward scan when ranges overlap.
+ */
+typedef struct {
+  uint32_t key;          /* RC: PCI segment, SMMU: node offset in the info table */
+  uint32_t input_base;
+  uint32_t input_end;    /* Inclusive, input_base + id_count */
+  uint32_t max_end;
+  uint32_t output_base;
+  uint32_t output_ref;
+  uint32_t node_index;   /* RC or SMMU index, in info table order */
+  uint32_t map_index;    /* Position of the mapping in the node */
+} IOVIRT_ID_RANGE;
+
+typedef struct {
+  uint32_t segment;
+  uint32_t rc_index;
+} IOVIRT_RC_SEG;
+
+typedef struct {
+  uint32_t         num_rc_ranges;
+  uint32_t         num_smmu_ranges;
+  uint32_t         num_rc_segs;
+  IOVIRT_ID_RANGE *rc_ranges;
+  IOVIRT_ID_RANGE *smmu_ranges;
+  IOVIRT_RC_SEG   *rc_segs;      /* Sorted by segment, first RC per segment */
+} IOVIRT_ID_INDEX;
+
+/* Result of translating one BDF table entry */
+typedef struct {
+  uint32_t bdf;
+  uint32_t device_id;
+  uint32_t stream_id;
+  uint32_t its_id;
+  uint32_t status;       /* 0 if translated, ACS_STATUS_ERR otherwise */
+} IOVIRT_DEVICE_ID_INFO;
+
 uint32_t val_iovirt_get_rc_index(uint32_t rc_seg_num);
 uint32_t val_iovirt_check_unique_ctx_intid(uint32_t smmu_index);
 uint64_t val_iovirt_get_named_comp_info(NAMED_COMP_INFO_e type, uint32_t index);
@@ -44,5 +83,6 @@ int val_iovirt_get_its_info(uint32_t type, uint32_t group_index, uint32_t param,
                             uint32_t *return_value);
 int val_iovirt_get_device_info(uint32_t rid, uint32_t segment, uint32_t *device_id,
                                uint32_t *stream_id, uint32_t *its_id);
+uint32_t val_iovirt_get_bdf_table_device_info(IOVIRT_DEVICE_ID_INFO *info, uint32_t max_entries);
 
 #endif
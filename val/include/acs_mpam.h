@@ -69,6 +69,29 @@ typedef enum {
 #define MAX_CPBM_WIDTH      32768
 #define MAX_BWPBM_WIDTH     4096
 
+/* Number of 32-bit words cached from the MSC feature ID space,
+   MPAMF_IDR (0x0000) to MPAMF_MBWUMON_IDR (0x0094) */
+#define MPAM_FEAT_CACHE_WORDS  38
+
+/* Snapshot of the read-only MSC ID registers. Most of them are indexed by
+   MPAMCFG_PART_SEL.RIS, so the snapshot is tagged with the RIS it was read under */
+typedef struct {
+  uint64_t valid;                         /* bit n set when word[n] is captured */
+  uint32_t ris;                           /* RIS selected when words were captured */
+  uint32_t ris_known;                     /* ris holds the selected RIS */
+  uint32_t word[MPAM_FEAT_CACHE_WORDS];   /* ID register words, by offset / 4 */
+} MPAM_MSC_FEAT_CACHE;
+
+/* Flat index entry of an MSC node in the MPAM info table, built once at
+   info table creation so accessors don't walk the variable length list */
+typedef struct {
+  MPAM_MSC_FEAT_CACHE feat;  /* ID register snapshot */
+  MPAM_MSC_NODE *msc_node;   /* MSC node in the MPAM info table */
+  uint64_t base_addr;        /* MMIO base or PCC subspace ID, per intrf_type */
+  uint32_t identifier;       /* MSC identifier used in PCC commands */
+  uint8_t  intrf_type;       /* MMIO or PCC */
+} MPAM_MSC_INDEX_ENTRY;
+
 void val_mpam_reg_write(MPAM_SYS_REGS reg_id, uint64_t write_data);
 uint64_t val_mpam_reg_read(MPAM_SYS_REGS reg_id);
 uint64_t AA64ReadMpamidr(void);
@@ -18,7 +18,17 @@
 #ifndef __ACS_NIST_H__
 #define __ACS_NIST_H__
 
+/* STS input mode: 0 - ASCII '0'/'1' per bit, 1 - binary, 8 bits per byte */
+#define NIST_INPUT_MODE_ASCII    0
+#define NIST_INPUT_MODE_BINARY   1
+#define NIST_INPUT_MODE          NIST_INPUT_MODE_BINARY
+
+#define NIST_STREAM_LEN          100000  /* Bits per STS bitstream */
+#define NIST_DEFAULT_STREAMS     10
+#define NIST_MAX_STREAMS         1000
+
 extern uint32_t test_select;
+extern uint32_t nist_num_streams;
 
 uint32_t n001_entry(uint32_t num_pe);
 double erf(double x);
@@ -73,6 +73,13 @@
 #define BAR_MASK           0xFFFFFFF0
 #define MSI_BIR_MASK       0xFFFFFFF8
 
+/* Segment/Bus to ECAM base lookup table */
+#define PCIE_ECAM_LOOKUP_MAX_SEG 256
+#define PCIE_ECAM_LOOKUP_NO_SEG  0xFFFF
+
+/* Config reads timed per path by val_pcie_cfg_access_benchmark */
+#define PCIE_CFG_BENCHMARK_ACCESSES 1024
+
 /* Allows storage of 2048 valid BDFs */
 #define PCIE_DEVICE_BDF_TABLE_SZ 8192
 
@@ -128,6 +135,24 @@ typedef struct {
   char                   err_str2[ERR_STRING_SIZE];
 } pcie_cfgreg_bitfield_entry;
 
+/**
+  @brief    Bit-field table entries that share one config register, checked together
+  @reg_type         Register type of the entries
+  @cap_id           Capability or extended capability ID, 0 for header registers
+  @reg_offset       Word aligned offset from the capability base
+  @dev_port_bitmask Union of the device/port bitmasks of the entries
+  @first            Position of the first entry in the grouped entry order
+  @count            Number of entries on this register
+**/
+typedef struct {
+  BITFIELD_REGISTER_TYPE reg_type;
+  uint16_t               cap_id;
+  uint16_t               reg_offset;
+  uint16_t               dev_port_bitmask;
+  uint8_t                first;
+  uint8_t                count;
+} pcie_bitfield_reg_group;
+
 typedef enum {
   MMIO = 0,
   IO = 1
@@ -153,11 +178,82 @@ typedef struct {
   pcie_device_attr device[];         ///< in the format of Segment/Bus/Dev/Func
 } pcie_device_bdf_table;
 
+/* Config space shadow of the discovered Functions, set to 0 to always read hardware */
+#ifndef PCIE_CFG_SHADOW_ENABLE
+#define PCIE_CFG_SHADOW_ENABLE   1
+#endif
+
+#define PCIE_CFG_SHADOW_HDR_SZ   0x40
+#define PCIE_CFG_SHADOW_MAX_CAP  16
+#define PCIE_CFG_SHADOW_MAX_ECAP 32
+
+/* Same number of Functions as the BDF table can hold */
+#define PCIE_CFG_SHADOW_MAX_ENTRIES ((PCIE_DEVICE_BDF_TABLE_SZ - sizeof(uint32_t)) / \
+                                     sizeof(pcie_device_attr))
+
+typedef struct {
+  uint16_t id;
+  uint16_t offset;
+} pcie_cfg_shadow_cap;
+
+/**
+  @brief    Snapshot of a Function config space taken during BDF table creation
+  @bdf              Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+  @header           Type 0/1 configuration header
+  @pciecs_base      Offset of PCI Express capability, 0 if not present
+  @pciecs_value     First dword of the PCI Express capability
+  @cap_complete     Set if whole capability list fit in cap[]
+  @ecap_complete    Set if whole extended capability list fit in ecap[]
+**/
+typedef struct {
+  uint32_t            bdf;
+  uint32_t            header[PCIE_CFG_SHADOW_HDR_SZ / 4];
+  uint32_t            pciecs_base;
+  uint32_t            pciecs_value;
+  uint8_t             num_cap;
+  uint8_t             num_ecap;
+  uint8_t             cap_complete;
+  uint8_t             ecap_complete;
+  pcie_cfg_shadow_cap cap[PCIE_CFG_SHADOW_MAX_CAP];
+  pcie_cfg_shadow_cap ecap[PCIE_CFG_SHADOW_MAX_ECAP];
+} pcie_cfg_shadow_entry;
+
+typedef struct {
+  uint32_t num_entries;
+  pcie_cfg_shadow_entry entry[];     ///< sorted on bdf
+} pcie_cfg_shadow_table;
+
+#define PCIE_CFG_SHADOW_TABLE_SZ (sizeof(pcie_cfg_shadow_table) + \
+                                  (PCIE_CFG_SHADOW_MAX_ENTRIES * sizeof(pcie_cfg_shadow_entry)))
+
+/* Marks an absent entry in the BDF topology index */
+#define PCIE_TOPOLOGY_NO_INDEX 0xFFFF
+
+/**
+  @brief    Topology index entry of a segment/bus, fields hold BDF table indices
+  @rootport         First Root Port whose bus window holds this bus
+  @parent_rp        First Root Port with this bus as secondary bus
+  @first            First Function on this bus
+  @first_type0      First Function with a Type 0 header on this bus
+**/
+typedef struct {
+  uint16_t rootport;
+  uint16_t parent_rp;
+  uint16_t first;
+  uint16_t first_type0;
+} pcie_topology_bus;
+
+typedef struct {
+  uint32_t          num_entries;
+  pcie_topology_bus bus[];           ///< [segment row][PCIE_MAX_BUS]
+} pcie_topology_index;
+
 void     val_pcie_write_cfg(uint32_t bdf, uint32_t offset, uint32_t data);
 void     val_pcie_io_write_cfg(uint32_t bdf, uint32_t offset, uint32_t data);
 uint32_t val_pcie_read_cfg(uint32_t bdf, uint32_t offset, uint32_t *data);
 uint32_t val_get_msi_vectors(uint32_t bdf, PERIPHERAL_VECTOR_LIST **mvector);
 uint64_t val_pcie_get_bdf_config_addr(uint32_t bdf);
+void     val_pcie_cfg_access_benchmark(uint32_t num_access);
 
 uint32_t val_pcie_bar_mem_read(uint32_t bdf, uint64_t address, uint32_t *data);
 uint32_t val_pcie_bar_mem_write(uint32_t bdf, uint64_t address, uint32_t data);
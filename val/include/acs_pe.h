@@ -34,6 +34,34 @@
 #define PE_PMUv3p5 0x06
 #define PE_PMUv3p7 0x07
 
+/* Secondary PE worker pool mailbox, one per PE index. The command line is
+   written only by the primary PE and the ack line only by the worker, so
+   neither side ever writes a line the other one is polling. Each half is
+   placed on its own cache writeback granule, see val_pe_pool_enable. */
+typedef struct {
+  uint64_t seq;       /* Bumped by the primary for each posted payload */
+  uint32_t exit;      /* Set by the primary to release the worker */
+  uint32_t posted;    /* Primary-private: payload posted, not yet reaped */
+} VAL_PE_POOL_CMD;
+
+typedef struct {
+  uint64_t done_seq;  /* Last seq the worker has completed */
+  uint32_t parked;    /* Worker is waiting in the pool */
+} VAL_PE_POOL_ACK;
+
+/* Open-addressed MPIDR to PE index hash used by val_pe_get_index_mpid */
+#define PE_MPID_HASH_MULT      0x9E3779B1
+#define PE_MPID_HASH_MIN_BITS  4
+
+typedef struct {
+  uint64_t mpidr;
+  uint32_t pe_index;
+  uint32_t valid;
+} PE_MPID_HASH_ENTRY;
+
+/* Lookups timed per table size by val_pe_index_benchmark */
+#define PE_INDEX_BENCH_LOOKUPS 4096
+
 //
 //  AARCH64 processor exception types.
 //
@@ -287,6 +315,8 @@ uint64_t AA64ReadTrcidr5(void);
 
 void DisableSpe(void);
 void ArmCallWFI(void);
+void ArmCallWFE(void);
+void ArmCallSEV(void);
 void ArmExecuteMemoryBarrier(void);
 void AA64WritePmsirr(uint64_t write_data);
 void AA64WritePmscr2(uint64_t write_data);
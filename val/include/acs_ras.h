@@ -25,13 +25,13 @@
 #define ERR_FR_CFI_MASK  (0x3ull << 10)
 #define ERR_FR_UI_MASK   (0x3ull << 4)
 
-#define ERR_STATUS_V_MASK   (0x1 << 30)
-#define ERR_STATUS_AV_MASK  (0x1 << 31)
-#define ERR_STATUS_UE_MASK  (0x1 << 29)
-#define ERR_STATUS_CE_MASK  (0x3 << 24)
-#define ERR_STATUS_DE_MASK  (0x1 << 23)
-#define ERR_STATUS_PN_MASK  (0x1 << 22)
-#define ERR_STATUS_CI_MASK  (0x1 << 19)
+#define ERR_STATUS_V_MASK   (0x1ull << 30)
+#define ERR_STATUS_AV_MASK  (0x1ull << 31)
+#define ERR_STATUS_UE_MASK  (0x1ull << 29)
+#define ERR_STATUS_CE_MASK  (0x3ull << 24)
+#define ERR_STATUS_DE_MASK  (0x1ull << 23)
+#define ERR_STATUS_PN_MASK  (0x1ull << 22)
+#define ERR_STATUS_CI_MASK  (0x1ull << 19)
 #define ERR_STATUS_CLEAR    (0xFFF80000)
 
 #define ERR_CTLR_CLEAR_MASK     0x3FFD
@@ -89,6 +89,15 @@ typedef enum {
     RAS_INFO_PE_FLAG             /* Resource Flag for RAS PE Node */
 } RAS_INFO_TYPE;
 
+/* Register accessor of one RAS node, resolved once from the RAS info table */
+typedef struct {
+    uint64_t base;             /* Error group base, MMIO interface only */
+    uint64_t valid_rec_mask;   /* Bit n clear if error record n is not implemented */
+    uint32_t start_rec_index;  /* First error record of the node */
+    uint32_t num_err_rec;      /* Number of error records of the node */
+    uint32_t is_mmio;          /* 1 for MMIO interface, 0 for system registers */
+} RAS_NODE_ACCESSOR;
+
 uint32_t val_ras_setup_error(RAS_ERR_IN_t in_param, RAS_ERR_OUT_t *out_param);
 uint32_t val_ras_inject_error(RAS_ERR_IN_t in_param, RAS_ERR_OUT_t *out_param);
 void val_ras_wait_timeout(uint32_t count);
@@ -98,6 +107,8 @@ uint32_t val_ras_check_plat_poison_support(void);
 
 uint64_t val_ras_reg_read(uint32_t node_index, uint32_t reg, uint32_t err_rec_idx);
 void val_ras_reg_write(uint32_t node_index, uint32_t reg, uint64_t write_data);
+uint32_t val_ras_scan_err_status(uint32_t node_index, uint64_t status_mask,
+                                 uint64_t *rec_bitmap);
 
 uint32_t ras001_entry(uint32_t num_pe);
 uint32_t ras002_entry(uint32_t num_pe);
@@ -160,4 +160,22 @@ void     ArmWriteCntvCval02(uint64_t val);
 uint64_t ArmReadCntkCtl12(void);
 void     ArmWriteCntkCtl12(uint64_t val);
 
+uint64_t ArmReadCnthCtl(void);
+void     ArmWriteCnthCtl(uint64_t val);
+
+/* CNTKCTL_EL1/CNTHCTL_EL2 event stream fields */
+#define CNTCTL_EVNTEN           (1ull << 2)
+#define CNTCTL_EVNTDIR          (1ull << 3)
+#define CNTCTL_EVNTI_SHIFT      4
+#define CNTCTL_EVNTI_MASK       (0xFull << CNTCTL_EVNTI_SHIFT)
+
+/* Event stream period used by val_wait_until, 2^10 counter ticks */
+#define VAL_WAIT_EVNTI          9
+
+/* Counter frequency assumed by val_wait_until when CNTFRQ_EL0 reads 0 */
+#define VAL_WAIT_DEFAULT_FREQ   1000000000ull
+
+uint64_t val_timer_event_stream_enable(uint32_t evnti);
+void     val_timer_event_stream_restore(uint64_t ctl);
+
 #endif // __ARM_ARCH_TIMER_H__
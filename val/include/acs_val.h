@@ -30,6 +30,20 @@ typedef struct {
   uint32_t    status;
 }VAL_SHARED_MEM_t;
 
+/* Per-PE records in the shared region are spaced by a multiple of the cache
+   writeback granule (CTR_EL0.CWG) so no two PEs share a line. CWG == 0 means
+   the granule is not reported; the architectural maximum is assumed. */
+#define VAL_SHARED_MEM_CWG_MAX        2048
+
+/* Status updates per PE issued by val_shared_mem_stress */
+#define VAL_SHARED_MEM_STRESS_UPDATES 1000
+
+volatile VAL_SHARED_MEM_t *
+val_shared_mem_entry(uint32_t index);
+
+void
+val_shared_mem_stress(uint32_t num_pe);
+
 uint64_t
 val_pe_reg_read(uint32_t reg_id);
 
@@ -65,6 +65,9 @@
   #define TIMEOUT_MEDIUM   PLATFORM_BM_OVERRIDE_TIMEOUT_MEDIUM
   #define TIMEOUT_SMALL    PLATFORM_BM_OVERRIDE_TIMEOUT_SMALL
 
+  void pal_heap_report(void);
+  void pal_mem_benchmark(void);
+
 #endif // TARGET_BAREMETAL
 
 #ifdef TARGET_LINUX
@@ -736,6 +739,8 @@ uint32_t pal_mem_set_wb_executable(void *addr, uint32_t size);
 
 /* Common Definitions */
 void     pal_print(char8_t *string, uint64_t data);
+void     pal_log_flush(void);
+void     pal_log_set_mode(uint32_t mode);
 void     pal_uart_print(int log, const char *fmt, ...);
 void     pal_print_raw(uint64_t addr, char8_t *string, uint64_t data);
 uint32_t pal_strncmp(char8_t *str1, char8_t *str2, uint32_t len);
@@ -784,6 +789,11 @@ void     pal_pe_data_cache_ops_by_va(uint64_t addr, uint32_t type);
 #define CLEAN                 0x2
 #define INVALIDATE            0x3
 
+/* Log file sink modes, see pal_log_set_mode */
+#define PAL_LOG_CONSOLE       0x0
+#define PAL_LOG_BUFFERED      0x1
+#define PAL_LOG_UNBUFFERED    0x2
+
 /* Exerciser definitions */
 #define MAX_ARRAY_SIZE 32
 #define TEST_REG_COUNT 10
@@ -1162,6 +1172,13 @@ typedef struct {
   uint64_t                         cmd_complete_update_preserve;
                                                             /* command complete update preserve */
   uint64_t                         cmd_complete_update_set; /* command complete update set mask */
+  uint32_t                         nominal_latency_usec;    /* expected command latency */
+  uint32_t                         platform_intr;           /* platform interrupt GSIV, 0 if none */
+  uint32_t                         platform_intr_flags;     /* platform interrupt flags */
+  ACPI_GENERIC_ADDRESS_STRUCTURE   platform_intr_ack_reg;   /* platform interrupt ack register */
+  uint64_t                         platform_intr_ack_preserve;
+                                                            /* platform interrupt ack preserve */
+  uint64_t                         platform_intr_ack_set;   /* platform interrupt ack set mask */
 } PCC_SUBSPACE_TYPE_3;
 
 typedef union {
@@ -1217,6 +1234,8 @@ typedef struct {
 #define MPAM_PCC_CMD_SUCCESS   0x0
 #define MPAM_PCC_SAFE_RETURN   0x0
 #define RETURN_FAILURE         0xFFFFFFFF
+#define PCC_TY3_FLAGS_OFFSET   4
+#define PCC_TY3_FLAG_NOTIFY    0x1
 #define PCC_TY3_CMD_OFFSET     12
 #define PCC_TY3_COMM_SPACE     16
 
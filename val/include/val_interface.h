@@ -62,6 +62,12 @@ void val_allocate_shared_mem(void);
 void val_free_shared_mem(void);
 void val_print(uint32_t level, char8_t *string, uint64_t data);
 void val_print_raw(uint64_t uart_addr, uint32_t level, char8_t *string, uint64_t data);
+void val_log_flush(void);
+void val_log_set_mode(uint32_t mode);
+void val_log_benchmark(uint32_t num_lines);
+
+/* Lines printed per log sink mode by val_log_benchmark */
+#define VAL_LOG_BENCHMARK_LINES 32
 void val_print_primary_pe(uint32_t level, char8_t *string, uint64_t data, uint32_t index);
 void val_print_test_start(char8_t *string);
 void val_print_test_end(uint32_t status, char8_t *string);
@@ -75,6 +81,18 @@ uint32_t execute_tests(void);
 uint32_t val_strncmp(char8_t *str1, char8_t *str2, uint32_t len);
 uint64_t val_time_delay_ms(uint64_t time_ms);
 
+/* Deadline based waits on the generic counter, sleeping in WFE between checks */
+#define VAL_WAIT_US_PER_SEC           1000000ull
+#define VAL_WAIT_INTR_TIMEOUT_US      (2 * VAL_WAIT_US_PER_SEC)   /* Test interrupt arrival */
+#define VAL_WAIT_PE_STATE_TIMEOUT_US  (1 * VAL_WAIT_US_PER_SEC)   /* PE power on or pool exit */
+#ifndef VAL_WAIT_TEST_TIMEOUT_US
+#define VAL_WAIT_TEST_TIMEOUT_US      (60 * VAL_WAIT_US_PER_SEC)  /* Payload on secondary PEs */
+#endif
+
+uint32_t val_wait_until(uint32_t (*done)(void *arg), void *arg, uint64_t timeout_us);
+uint32_t val_wait_for_flag(volatile uint32_t *flag, uint64_t timeout_us);
+uint32_t val_wait_for_status(uint32_t index, uint64_t timeout_us);
+
 /* VAL PE APIs */
 typedef enum {
   PE_FEAT_MPAM,
@@ -86,6 +104,10 @@ void     val_pe_cache_clean_invalidate_range(uint64_t start_addr, uint64_t lengt
 void     val_pe_cache_invalidate_range(uint64_t start_addr, uint64_t length);
 void     val_pe_free_info_table(void);
 void     val_execute_on_pe(uint32_t index, void (*payload)(void), uint64_t args);
+uint32_t val_pe_pool_enable(void);
+uint32_t val_pe_pool_wait(uint32_t num_pe, uint64_t timeout_us);
+void     val_pe_pool_release(void);
+uint32_t val_pe_cache_wb_granule(void);
 void     val_smbios_create_info_table(uint64_t *smbios_info_table);
 void     val_smbios_free_info_table(void);
 
@@ -456,6 +478,7 @@ uint32_t val_bsa_exerciser_execute_tests(uint32_t *g_sw_view);
 
 /* NIST VAL APIs */
 uint32_t val_nist_generate_rng(uint32_t *rng_buffer);
+uint32_t val_nist_generate_rng_block(uint32_t *rng_buffer, uint32_t num_words);
 
 /* PMU test related APIS*/
 void     val_pmu_create_info_table(uint64_t *pmu_info_table);
@@ -612,6 +635,7 @@ uint32_t val_pcbsa_tpm2_execute_tests(uint32_t level, uint32_t num_pe);
 void val_pcc_create_info_table(uint64_t *pcc_info_table);
 void *val_pcc_cmd_response(uint32_t subspace_id, uint32_t command, void *data, uint32_t data_size);
 uint32_t val_pcc_get_ss_info_idx(uint32_t subspace_id);
+void val_pcc_report_stats(void);
 void val_pcc_free_info_table(void);
 
 typedef enum {
@@ -19,11 +19,19 @@
 #include "include/acs_gic.h"
 #include "include/acs_gic_support.h"
 #include "include/acs_common.h"
+#include "include/acs_pe.h"
 #include "driver/gic/gic.h"
 #include "include/pal_interface.h"
 
 GIC_INFO_TABLE  *g_gic_info_table;
 
+/* Redistributor bases sorted by affinity, built once by val_gic_create_info_table */
+static GIC_RDBASE_ENTRY *g_gic_rdbase_map;
+static uint32_t          g_gic_rdbase_count;
+
+static void val_gic_rdbase_map_init(void);
+static void val_gic_rdbase_map_free(void);
+
 /**
   @brief   This API will call PAL layer to fill in the GIC information
            into the g_gic_info_table pointer.
@@ -71,6 +79,8 @@ val_gic_create_info_table(uint64_t *gic_info_table)
       return ACS_STATUS_ERR;
   }
 
+  val_gic_rdbase_map_init();
+
   if (pal_target_is_dt())
       val_gic_init();
   if (pal_target_is_bm())
@@ -89,6 +99,8 @@ val_gic_create_info_table(uint64_t *gic_info_table)
 void
 val_gic_free_info_table(void)
 {
+    val_gic_rdbase_map_free();
+
     if (g_gic_info_table != NULL) {
         pal_mem_free_aligned((void *)g_gic_info_table);
         g_gic_info_table = NULL;
@@ -143,14 +155,13 @@ uint32_t val_get_num_nongic_ctrl(void)
 }
 
 /**
-  @brief   This API returns the base address of the GIC Redistributor for a PE
-           1. Caller       -  Test Suite
-           2. Prerequisite -  val_gic_create_info_table
+  @brief   Walk the redistributor frames for the one matching a PE. Only used
+           if the redistributor map could not be built.
   @param   mpidr - PE mpidr value
   @return  Address of GIC Redistributor
 **/
-addr_t
-val_gic_get_pe_rdbase(uint64_t mpidr)
+static addr_t
+val_gic_rdbase_scan(uint64_t mpidr)
 {
   uint32_t     gicrd_baselen;
   uint32_t     gicr_rdindex = 0;
@@ -211,6 +222,153 @@ val_gic_get_pe_rdbase(uint64_t mpidr)
   return 0;
 }
 
+/**
+  @brief   Free the redistributor map
+  @param   None
+  @return  None
+**/
+static void
+val_gic_rdbase_map_free(void)
+{
+  if (g_gic_rdbase_map != NULL) {
+      pal_mem_free_aligned((void *)g_gic_rdbase_map);
+      g_gic_rdbase_map = NULL;
+  }
+  g_gic_rdbase_count = 0;
+
+  val_data_cache_ops_by_va((addr_t)&g_gic_rdbase_map, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&g_gic_rdbase_count, CLEAN_AND_INVALIDATE);
+}
+
+/**
+  @brief   Record the redistributor frames of one GICR region, or the single
+           frame of a GICC entry when length is 0. The frame stride follows
+           GICR_TYPER.VLPIS, GICv4 redistributors add VLPI and reserved frames.
+  @param   base   - Region base
+  @param   length - Region length, 0 for a GICC redistributor
+  @param   map    - Map being filled
+  @param   count  - Entries in use, updated
+  @param   max    - Map capacity
+  @return  None
+**/
+static void
+val_gic_rdbase_map_add(uint64_t base, uint32_t length, GIC_RDBASE_ENTRY *map,
+                       uint32_t *count, uint32_t max)
+{
+  uint64_t     frame = base;
+  uint64_t     typer;
+  uint64_t     granularity;
+
+  do {
+      if (*count >= max)
+          return;
+
+      typer = val_mmio_read64(frame + GICR_TYPER);
+      map[*count].affinity = (uint32_t)((typer & GICR_TYPER_AFF) >> 32);
+      map[*count].rd_base  = frame;
+      (*count)++;
+
+      granularity = GICR_CTLR_FRAME_SIZE + GICR_SGI_PPI_FRAME_SIZE;
+      if (typer & GICR_TYPER_VLPIS)
+          granularity += GICR_VLPI_FRAME_SIZE + GICR_RES_FRAME_SIZE;
+
+      /* Move to the next GIC Redistributor frame */
+      frame += granularity;
+  } while (length && !(typer & GICR_TYPER_LAST) && (frame < (base + length)));
+}
+
+/**
+  @brief   Build the affinity to redistributor base map. GICR_TYPER of every
+           frame is read once here, lookups then need no MMIO. The map is
+           cleaned to the point of coherency so secondary PEs can use it.
+  @param   None
+  @return  None
+**/
+static void
+val_gic_rdbase_map_init(void)
+{
+  GIC_INFO_ENTRY   *gic_entry;
+  GIC_RDBASE_ENTRY *map;
+  GIC_RDBASE_ENTRY  tmp;
+  uint32_t          max = 0, count = 0, i, j;
+
+  val_gic_rdbase_map_free();
+
+  /* Upper bound, every frame of a GICR region may be a GICv3 sized one */
+  for (gic_entry = g_gic_info_table->gic_info; gic_entry->type != 0xFF; gic_entry++) {
+      if (gic_entry->type == ENTRY_TYPE_GICR_GICRD)
+          max += gic_entry->length / (GICR_CTLR_FRAME_SIZE + GICR_SGI_PPI_FRAME_SIZE) + 1;
+      else if (gic_entry->type == ENTRY_TYPE_GICC_GICRD)
+          max++;
+  }
+
+  if (max == 0)
+      return;
+
+  map = (GIC_RDBASE_ENTRY *)pal_aligned_alloc(MEM_ALIGN_4K, max * sizeof(GIC_RDBASE_ENTRY));
+  if (map == NULL) {
+      val_print(ACS_PRINT_WARN, "\n GIC_INFO: RD base map not allocated, using frame walk", 0);
+      return;
+  }
+
+  for (gic_entry = g_gic_info_table->gic_info; gic_entry->type != 0xFF; gic_entry++) {
+      if (gic_entry->type == ENTRY_TYPE_GICR_GICRD)
+          val_gic_rdbase_map_add(gic_entry->base, gic_entry->length, map, &count, max);
+      else if (gic_entry->type == ENTRY_TYPE_GICC_GICRD)
+          val_gic_rdbase_map_add(gic_entry->base, 0, map, &count, max);
+  }
+
+  /* Stable insertion sort, frames are mostly in affinity order already */
+  for (i = 1; i < count; i++) {
+      tmp = map[i];
+      for (j = i; j > 0 && map[j - 1].affinity > tmp.affinity; j--)
+          map[j] = map[j - 1];
+      map[j] = tmp;
+  }
+
+  val_pe_cache_clean_range((uint64_t)map, count * sizeof(GIC_RDBASE_ENTRY));
+  g_gic_rdbase_map = map;
+  g_gic_rdbase_count = count;
+  val_data_cache_ops_by_va((addr_t)&g_gic_rdbase_map, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&g_gic_rdbase_count, CLEAN_AND_INVALIDATE);
+
+  val_print(ACS_PRINT_DEBUG, " GIC_INFO: RD frames mapped           : %4d\n", count);
+}
+
+/**
+  @brief   This API returns the base address of the GIC Redistributor for a PE
+           1. Caller       -  Test Suite
+           2. Prerequisite -  val_gic_create_info_table
+  @param   mpidr - PE mpidr value
+  @return  Address of GIC Redistributor
+**/
+addr_t
+val_gic_get_pe_rdbase(uint64_t mpidr)
+{
+  uint32_t     pe_affinity;
+  uint32_t     lo = 0, hi, mid;
+
+  if (g_gic_rdbase_map == NULL)
+      return val_gic_rdbase_scan(mpidr);
+
+  pe_affinity = (uint32_t)((mpidr & (PE_AFF0 | PE_AFF1 | PE_AFF2)) | ((mpidr & PE_AFF3) >> 8));
+
+  /* First entry with this affinity, the one the frame walk would find */
+  hi = g_gic_rdbase_count;
+  while (lo < hi) {
+      mid = lo + (hi - lo) / 2;
+      if (g_gic_rdbase_map[mid].affinity < pe_affinity)
+          lo = mid + 1;
+      else
+          hi = mid;
+  }
+
+  if ((lo < g_gic_rdbase_count) && (g_gic_rdbase_map[lo].affinity == pe_affinity))
+      return g_gic_rdbase_map[lo].rd_base;
+
+  return 0;
+}
+
 /**
   @brief   This API returns the base address of the GIC Redistributor
            1. Caller       -  Test Suite
@@ -20,10 +20,21 @@
 #include "include/acs_iovirt.h"
 #include "include/acs_smmu.h"
 #include "include/acs_mmu.h"
+#include "include/acs_pcie.h"
 
 IOVIRT_INFO_TABLE *g_iovirt_info_table;
 uint32_t g_num_smmus;
 
+/* Sorted ID mapping index, built once by val_iovirt_create_info_table */
+static IOVIRT_ID_INDEX g_iovirt_id_index;
+static uint32_t g_iovirt_id_index_built;
+
+/* iovirt_translate_id status, val_iovirt_get_device_info prints the reason */
+#define IOVIRT_XLATE_OK            0
+#define IOVIRT_XLATE_NO_RC_MAP     1
+#define IOVIRT_XLATE_BAD_OUTPUT    2
+#define IOVIRT_XLATE_NO_SMMU_MAP   3
+
 /**
   @brief   This API is a single point of entry to retrieve
            SMMU information stored in the IoVirt Info table
@@ -146,62 +157,314 @@ val_iovirt_get_pcie_rc_info(PCIE_RC_INFO_e type, uint32_t index)
 }
 
 /**
-  @brief  Calculate the device id and stream id orresponding to the requestor id
-  @param  rid          Requestor ID
-  @param  segment      pci_segment_number
-  @param  *device_id   Pointer to device id
-  @param  *stream_id   Pointer to stream id
-  @param  *its_id      Pointer to its id
-  @return status
+  @brief  Order of two ID ranges by (key, input_base)
+  @param  a  First range
+  @param  b  Second range
+  @return 1 if a sorts after b, else 0
 **/
+static uint32_t
+iovirt_range_after(IOVIRT_ID_RANGE *a, IOVIRT_ID_RANGE *b)
+{
+  if (a->key != b->key)
+      return (a->key > b->key);
 
-int
-val_iovirt_get_device_info(uint32_t rid, uint32_t segment, uint32_t *device_id,
-                           uint32_t *stream_id, uint32_t *its_id)
+  return (a->input_base > b->input_base);
+}
+
+/**
+  @brief  Sort ID ranges by (key, input_base) and compute the running
+          max_end of each key group
+  @param  range  Array of ranges
+  @param  num    Number of ranges
+  @return None
+**/
+static void
+iovirt_sort_ranges(IOVIRT_ID_RANGE *range, uint32_t num)
 {
-  uint32_t i, j, id = 0;
-  uint32_t sid, did, oref;
-  uint32_t itsid = 0;
-  uint32_t mapping_found;
-  IOVIRT_BLOCK *block;
+  uint32_t gap, i, j;
+  IOVIRT_ID_RANGE tmp;
+
+  /* Shell sort, in place and without recursion */
+  for (gap = num / 2; gap > 0; gap /= 2) {
+      for (i = gap; i < num; i++) {
+          tmp = range[i];
+          for (j = i; j >= gap && iovirt_range_after(&range[j - gap], &tmp); j -= gap)
+              range[j] = range[j - gap];
+          range[j] = tmp;
+      }
+  }
+
+  for (i = 0; i < num; i++) {
+      range[i].max_end = range[i].input_end;
+      if (i && range[i - 1].key == range[i].key && range[i - 1].max_end > range[i].max_end)
+          range[i].max_end = range[i - 1].max_end;
+  }
+}
+
+/**
+  @brief  Append the ID mappings of one IORT node to a range array
+  @param  range       Next free entry in the range array
+  @param  block       IORT node
+  @param  key         Segment for an RC, node offset for an SMMU
+  @param  node_index  RC or SMMU index of the node
+  @return Number of ranges added
+**/
+static uint32_t
+iovirt_add_ranges(IOVIRT_ID_RANGE *range, IOVIRT_BLOCK *block, uint32_t key, uint32_t node_index)
+{
+  uint32_t j;
   NODE_DATA_MAP *map;
-  if (g_iovirt_info_table == NULL)
+
+  for (j = 0, map = &block->data_map[0]; j < block->num_data_map; j++, map++, range++)
   {
-      val_print(ACS_PRINT_ERR, "\n       GET_DEVICE_ID: iovirt info table is not created", 0);
-      return ACS_STATUS_ERR;
+      range->key         = key;
+      range->input_base  = (*map).map.input_base;
+      range->input_end   = (*map).map.input_base + (*map).map.id_count;
+      /* Clamp a range running past the ID space so the sort order holds */
+      if (range->input_end < range->input_base)
+          range->input_end = ~((uint32_t)0);
+      range->output_base = (*map).map.output_base;
+      range->output_ref  = (*map).map.output_ref;
+      range->node_index  = node_index;
+      range->map_index   = j;
   }
-  if (!device_id) {
-      val_print(ACS_PRINT_ERR, "\n       GET_DEVICE_ID: Invalid parameters", 0);
-      return ACS_STATUS_ERR;
+
+  return block->num_data_map;
+}
+
+/**
+  @brief  Free the ID mapping index
+  @param  None
+  @return None
+**/
+static void
+iovirt_free_id_index(void)
+{
+  if (g_iovirt_id_index.rc_ranges)
+      pal_mem_free(g_iovirt_id_index.rc_ranges);
+  if (g_iovirt_id_index.smmu_ranges)
+      pal_mem_free(g_iovirt_id_index.smmu_ranges);
+  if (g_iovirt_id_index.rc_segs)
+      pal_mem_free(g_iovirt_id_index.rc_segs);
+
+  pal_mem_set(&g_iovirt_id_index, sizeof(g_iovirt_id_index), 0);
+  g_iovirt_id_index_built = 0;
+}
+
+/**
+  @brief  Build the sorted RC and SMMU ID mapping index from the info table.
+          If memory cannot be allocated the lookups keep walking the table.
+  @param  None
+  @return None
+**/
+static void
+iovirt_build_id_index(void)
+{
+  uint32_t i, j, num_rc = 0, num_smmu = 0, num_rc_nodes = 0;
+  uint32_t rc_index = 0, smmu_index = 0;
+  IOVIRT_BLOCK *block;
+  IOVIRT_ID_INDEX *idx = &g_iovirt_id_index;
+  IOVIRT_RC_SEG tmp;
+
+  iovirt_free_id_index();
+
+  block = &g_iovirt_info_table->blocks[0];
+  for (i = 0; i < g_iovirt_info_table->num_blocks; i++, block = IOVIRT_NEXT_BLOCK(block))
+  {
+      if (block->type == IOVIRT_NODE_PCI_ROOT_COMPLEX) {
+          num_rc += block->num_data_map;
+          num_rc_nodes++;
+      } else if (block->type == IOVIRT_NODE_SMMU || block->type == IOVIRT_NODE_SMMU_V3)
+          num_smmu += block->num_data_map;
+  }
+
+  if (num_rc)
+      idx->rc_ranges = pal_mem_alloc(num_rc * sizeof(IOVIRT_ID_RANGE));
+  if (num_smmu)
+      idx->smmu_ranges = pal_mem_alloc(num_smmu * sizeof(IOVIRT_ID_RANGE));
+  if (num_rc_nodes)
+      idx->rc_segs = pal_mem_alloc(num_rc_nodes * sizeof(IOVIRT_RC_SEG));
+
+  if ((num_rc && !idx->rc_ranges) || (num_smmu && !idx->smmu_ranges) ||
+      (num_rc_nodes && !idx->rc_segs)) {
+      val_print(ACS_PRINT_WARN, "\n   IOVIRT: ID index allocation failed, using table walk", 0);
+      iovirt_free_id_index();
+      return;
   }
 
-  /* Search for root complex block with same segment number, and in whose id */
-  /* mapping range 'rid' falls. Calculate the output id */
   block = &g_iovirt_info_table->blocks[0];
-  mapping_found = 0;
   for (i = 0; i < g_iovirt_info_table->num_blocks; i++, block = IOVIRT_NEXT_BLOCK(block))
   {
-      if (block->type == IOVIRT_NODE_PCI_ROOT_COMPLEX
-          && block->data.rc.segment == segment)
-      {
-          for (j = 0, map = &block->data_map[0]; j < block->num_data_map; j++, map++)
-          {
-              if(rid >= (*map).map.input_base
-                      && rid <= ((*map).map.input_base + (*map).map.id_count))
-              {
-                  id =  (rid - (*map).map.input_base) + (*map).map.output_base;
-                  oref = (*map).map.output_ref;
-                  mapping_found = 1;
+      if (block->type == IOVIRT_NODE_PCI_ROOT_COMPLEX) {
+          idx->num_rc_ranges += iovirt_add_ranges(&idx->rc_ranges[idx->num_rc_ranges], block,
+                                                  block->data.rc.segment, rc_index);
+
+          /* Keep only the first RC of a segment, as the table walk did */
+          for (j = 0; j < idx->num_rc_segs; j++)
+              if (idx->rc_segs[j].segment == block->data.rc.segment)
                   break;
-              }
+          if (j == idx->num_rc_segs) {
+              idx->rc_segs[j].segment  = block->data.rc.segment;
+              idx->rc_segs[j].rc_index = rc_index;
+              idx->num_rc_segs++;
           }
+          rc_index++;
+      } else if (block->type == IOVIRT_NODE_SMMU || block->type == IOVIRT_NODE_SMMU_V3) {
+          idx->num_smmu_ranges += iovirt_add_ranges(&idx->smmu_ranges[idx->num_smmu_ranges],
+                                                    block,
+                                                    (uint32_t)((uint8_t *)block -
+                                                               (uint8_t *)g_iovirt_info_table),
+                                                    smmu_index);
+          smmu_index++;
       }
   }
-  if (!mapping_found) {
-      val_print(ACS_PRINT_ERR,
-             "\n       RID to Stream/Dev ID map not found ", 0);
-      return ACS_STATUS_ERR;
+
+  iovirt_sort_ranges(idx->rc_ranges, idx->num_rc_ranges);
+  iovirt_sort_ranges(idx->smmu_ranges, idx->num_smmu_ranges);
+
+  for (i = 1; i < idx->num_rc_segs; i++) {
+      tmp = idx->rc_segs[i];
+      for (j = i; j > 0 && idx->rc_segs[j - 1].segment > tmp.segment; j--)
+          idx->rc_segs[j] = idx->rc_segs[j - 1];
+      idx->rc_segs[j] = tmp;
+  }
+
+  g_iovirt_id_index_built = 1;
+  val_print(ACS_PRINT_DEBUG, "\n   IOVIRT: ID index RC maps %d", idx->num_rc_ranges);
+  val_print(ACS_PRINT_DEBUG, ", SMMU maps %d\n", idx->num_smmu_ranges);
+}
+
+/**
+  @brief  Binary search the ID index for the mapping of an input ID. When
+          mappings overlap, the table walk picked the last matching node and
+          the first matching mapping within it, the same one is returned.
+  @param  range  Sorted range array
+  @param  num    Number of ranges
+  @param  key    Segment for RC ranges, node offset for SMMU ranges
+  @param  id     Input ID
+  @return Matching range, NULL if none
+**/
+static IOVIRT_ID_RANGE *
+iovirt_find_range(IOVIRT_ID_RANGE *range, uint32_t num, uint32_t key, uint32_t id)
+{
+  uint32_t lo = 0, hi = num, mid;
+  IOVIRT_ID_RANGE *best = NULL;
+  IOVIRT_ID_RANGE *entry;
+
+  /* First entry sorting after (key, id) */
+  while (lo < hi) {
+      mid = lo + (hi - lo) / 2;
+      if (range[mid].key < key || (range[mid].key == key && range[mid].input_base <= id))
+          lo = mid + 1;
+      else
+          hi = mid;
+  }
+
+  /* Walk back while an earlier range of this key can still reach id */
+  while (lo > 0) {
+      entry = &range[--lo];
+      if (entry->key != key || entry->max_end < id)
+          break;
+      if (id > entry->input_end)
+          continue;
+      if (!best || entry->node_index > best->node_index ||
+          (entry->node_index == best->node_index && entry->map_index < best->map_index))
+          best = entry;
+  }
+
+  return best;
+}
+
+/**
+  @brief  Map an input ID through the ID mappings of an RC or SMMU node
+  @param  block      Info table node, used by the table walk
+  @param  key        Segment for an RC, node offset for an SMMU
+  @param  in_id      Input ID
+  @param  *out_id    Output ID
+  @param  *oref      Output reference of the mapping
+  @param  *node_idx  RC or SMMU index of the node owning the mapping, may be NULL
+  @return 1 if a mapping was found, else 0
+**/
+static uint32_t
+iovirt_map_id(IOVIRT_BLOCK *block, uint32_t key, uint32_t in_id,
+              uint32_t *out_id, uint32_t *oref, uint32_t *node_idx)
+{
+  uint32_t i, j, k;
+  uint32_t found = 0;
+  uint32_t is_rc = (block == NULL);
+  IOVIRT_ID_RANGE *range;
+  NODE_DATA_MAP *map;
+
+  if (g_iovirt_id_index_built) {
+      if (is_rc)
+          range = iovirt_find_range(g_iovirt_id_index.rc_ranges,
+                                    g_iovirt_id_index.num_rc_ranges, key, in_id);
+      else
+          range = iovirt_find_range(g_iovirt_id_index.smmu_ranges,
+                                    g_iovirt_id_index.num_smmu_ranges, key, in_id);
+      if (!range)
+          return 0;
+
+      *out_id = (in_id - range->input_base) + range->output_base;
+      *oref = range->output_ref;
+      if (node_idx)
+          *node_idx = range->node_index;
+      return 1;
+  }
+
+  /* Search for root complex block with same segment number, and in whose id */
+  /* mapping range 'rid' falls. Calculate the output id */
+  if (is_rc)
+      block = &g_iovirt_info_table->blocks[0];
+
+  for (i = 0, k = 0; i < (is_rc ? g_iovirt_info_table->num_blocks : 1);
+       i++, block = IOVIRT_NEXT_BLOCK(block))
+  {
+      if (is_rc && (block->type != IOVIRT_NODE_PCI_ROOT_COMPLEX))
+          continue;
+      if (is_rc && (block->data.rc.segment != key)) {
+          k++;
+          continue;
+      }
+      for (j = 0, map = &block->data_map[0]; j < block->num_data_map; j++, map++)
+      {
+          if (in_id >= (*map).map.input_base
+                  && in_id <= ((*map).map.input_base + (*map).map.id_count))
+          {
+              *out_id = (in_id - (*map).map.input_base) + (*map).map.output_base;
+              *oref = (*map).map.output_ref;
+              if (node_idx)
+                  *node_idx = k;
+              found = 1;
+              break;
+          }
+      }
+      k++;
   }
+
+  return found;
+}
+
+/**
+  @brief  Translate a requestor ID to stream, device and ITS IDs
+  @param  rid          Requestor ID
+  @param  segment      pci_segment_number
+  @param  *device_id   Pointer to device id
+  @param  *stream_id   Pointer to stream id
+  @param  *its_id      Pointer to its id
+  @return IOVIRT_XLATE_OK or the failing step
+**/
+static uint32_t
+iovirt_translate_id(uint32_t rid, uint32_t segment, uint32_t *device_id,
+                    uint32_t *stream_id, uint32_t *its_id)
+{
+  uint32_t id = 0, oref = 0, sid, did;
+  uint32_t itsid = 0;
+  IOVIRT_BLOCK *block;
+
+  if (!iovirt_map_id(NULL, segment, rid, &id, &oref, NULL))
+      return IOVIRT_XLATE_NO_RC_MAP;
+
   /* If output reference node is to ITS group, 'id' is device id */
   block = (IOVIRT_BLOCK*)((uint8_t*)g_iovirt_info_table + oref);
   if(block->type == IOVIRT_NODE_ITS_GROUP)
@@ -215,42 +478,115 @@ val_iovirt_get_device_info(uint32_t rid, uint32_t segment, uint32_t *device_id,
   else if(block->type == IOVIRT_NODE_SMMU || block->type == IOVIRT_NODE_SMMU_V3)
   {
       sid = id;
-      id = 0;
-      mapping_found = 0;
-      for(i = 0, map = &block->data_map[0]; i < block->num_data_map; i++, map++)
-      {
-          if(sid >= (*map).map.input_base && sid <= ((*map).map.input_base +
-                                                    (*map).map.id_count))
-          {
-              did =  (sid - (*map).map.input_base) + (*map).map.output_base;
-              oref = (*map).map.output_ref;
-              mapping_found = 1;
-              break;
-          }
-      }
+      if (!iovirt_map_id(block, oref, sid, &did, &oref, NULL))
+          return IOVIRT_XLATE_NO_SMMU_MAP;
+
       /* If output reference node is to ITS group */
       block = (IOVIRT_BLOCK*)((uint8_t*)g_iovirt_info_table + oref);
       if(block->type == IOVIRT_NODE_ITS_GROUP)
           itsid = block->data_map[0].id[0];
   }
   else
-  {
-    val_print(ACS_PRINT_ERR, "\n       GET_DEVICE_ID: Invalid mapping for RC in IORT", 0);
-    return ACS_STATUS_ERR;
-  }
-  if (!mapping_found)
-  {
-    val_print(ACS_PRINT_ERR,
-                        "\n       GET_DEVICE_ID: Stream ID to Device ID mapping not found", 0);
-    return ACS_STATUS_ERR;
-  }
+      return IOVIRT_XLATE_BAD_OUTPUT;
 
   if (its_id)
       *its_id = itsid;
   if (stream_id)
       *stream_id = sid;
   *device_id = did;
-  return 0;
+  return IOVIRT_XLATE_OK;
+}
+
+/**
+  @brief  Calculate the device id and stream id orresponding to the requestor id
+  @param  rid          Requestor ID
+  @param  segment      pci_segment_number
+  @param  *device_id   Pointer to device id
+  @param  *stream_id   Pointer to stream id
+  @param  *its_id      Pointer to its id
+  @return status
+**/
+
+int
+val_iovirt_get_device_info(uint32_t rid, uint32_t segment, uint32_t *device_id,
+                           uint32_t *stream_id, uint32_t *its_id)
+{
+  if (g_iovirt_info_table == NULL)
+  {
+      val_print(ACS_PRINT_ERR, "\n       GET_DEVICE_ID: iovirt info table is not created", 0);
+      return ACS_STATUS_ERR;
+  }
+  if (!device_id) {
+      val_print(ACS_PRINT_ERR, "\n       GET_DEVICE_ID: Invalid parameters", 0);
+      return ACS_STATUS_ERR;
+  }
+
+  switch (iovirt_translate_id(rid, segment, device_id, stream_id, its_id))
+  {
+      case IOVIRT_XLATE_OK:
+          return 0;
+      case IOVIRT_XLATE_NO_RC_MAP:
+          val_print(ACS_PRINT_ERR,
+                 "\n       RID to Stream/Dev ID map not found ", 0);
+          break;
+      case IOVIRT_XLATE_BAD_OUTPUT:
+          val_print(ACS_PRINT_ERR, "\n       GET_DEVICE_ID: Invalid mapping for RC in IORT", 0);
+          break;
+      default:
+          val_print(ACS_PRINT_ERR,
+                        "\n       GET_DEVICE_ID: Stream ID to Device ID mapping not found", 0);
+          break;
+  }
+
+  return ACS_STATUS_ERR;
+}
+
+/**
+  @brief  Translate every entry of the PCIe BDF table to its stream, device
+          and ITS IDs in one pass. Entries without a mapping are marked with
+          ACS_STATUS_ERR in their status field and are not reported.
+          1. Prerequisite -  val_iovirt_create_info_table, BDF table created
+  @param  info         Array receiving one result per BDF table entry
+  @param  max_entries  Number of elements in info
+  @return Number of entries filled
+**/
+uint32_t
+val_iovirt_get_bdf_table_device_info(IOVIRT_DEVICE_ID_INFO *info, uint32_t max_entries)
+{
+  uint32_t i, num, bdf, mapped = 0;
+  pcie_device_bdf_table *bdf_tbl_ptr;
+
+  bdf_tbl_ptr = val_pcie_bdf_table_ptr();
+  if (g_iovirt_info_table == NULL || bdf_tbl_ptr == NULL || info == NULL)
+  {
+      val_print(ACS_PRINT_ERR, "\n       GET_DEVICE_ID: iovirt or BDF table is not created", 0);
+      return 0;
+  }
+
+  num = bdf_tbl_ptr->num_entries;
+  if (num > max_entries)
+      num = max_entries;
+
+  for (i = 0; i < num; i++)
+  {
+      bdf = bdf_tbl_ptr->device[i].bdf;
+      info[i].bdf = bdf;
+      info[i].device_id = 0;
+      info[i].stream_id = ~((uint32_t)0);
+      info[i].its_id = 0;
+      info[i].status = ACS_STATUS_ERR;
+
+      if (iovirt_translate_id(PCIE_CREATE_BDF_PACKED(bdf), PCIE_EXTRACT_BDF_SEG(bdf),
+                              &info[i].device_id, &info[i].stream_id,
+                              &info[i].its_id) == IOVIRT_XLATE_OK) {
+          info[i].status = 0;
+          mapped++;
+      }
+  }
+
+  val_print(ACS_PRINT_DEBUG, "\n       BDF table ID translation: %d mapped", mapped);
+  val_print(ACS_PRINT_DEBUG, " of %d", num);
+  return num;
 }
 
 /**
@@ -278,6 +614,7 @@ val_iovirt_create_info_table(uint64_t *iovirt_info_table)
   g_iovirt_info_table = (IOVIRT_INFO_TABLE *)iovirt_info_table;
 
   pal_iovirt_create_info_table(g_iovirt_info_table);
+  iovirt_build_id_index();
 
   g_num_smmus = (uint32_t)val_iovirt_get_smmu_info(SMMU_NUM_CTRL, 0);
   val_print(ACS_PRINT_TEST,
@@ -317,6 +654,8 @@ val_iovirt_create_info_table(uint64_t *iovirt_info_table)
 void
 val_iovirt_free_info_table(void)
 {
+    iovirt_free_id_index();
+
     if (g_iovirt_info_table != NULL) {
         pal_mem_free_aligned((void *)g_iovirt_info_table);
         g_iovirt_info_table = NULL;
@@ -342,6 +681,22 @@ val_iovirt_get_rc_smmu_index(uint32_t rc_seg_num, uint32_t rid)
 
   uint32_t num_smmu;
   uint64_t smmu_base;
+  uint32_t sid, did, oref, smmu_index;
+  IOVIRT_BLOCK *block;
+
+  if (g_iovirt_id_index_built) {
+      /* RC mapping to an SMMU node with a mapping for the stream id */
+      if (iovirt_map_id(NULL, rc_seg_num, rid, &sid, &oref, NULL)) {
+          block = (IOVIRT_BLOCK *)((uint8_t *)g_iovirt_info_table + oref);
+          if ((block->type == IOVIRT_NODE_SMMU || block->type == IOVIRT_NODE_SMMU_V3) &&
+              iovirt_map_id(block, oref, sid, &did, &oref, &smmu_index))
+              return smmu_index;
+      }
+
+      val_print(ACS_PRINT_INFO, "\n       RC with segment number %d is not behind SMMU",
+                rc_seg_num);
+      return ACS_INVALID_INDEX;
+  }
 
   smmu_base = pal_iovirt_get_rc_smmu_base(g_iovirt_info_table, rc_seg_num, rid);
   if (smmu_base) {
@@ -529,6 +884,23 @@ val_iovirt_get_rc_index(uint32_t rc_seg_num)
       return 0;
   }
 
+  if (g_iovirt_id_index_built) {
+      uint32_t lo = 0, hi = g_iovirt_id_index.num_rc_segs, mid;
+
+      while (lo < hi) {
+          mid = lo + (hi - lo) / 2;
+          if (g_iovirt_id_index.rc_segs[mid].segment == rc_seg_num)
+              return g_iovirt_id_index.rc_segs[mid].rc_index;
+          if (g_iovirt_id_index.rc_segs[mid].segment < rc_seg_num)
+              lo = mid + 1;
+          else
+              hi = mid;
+      }
+
+      val_print(ACS_PRINT_ERR, "GET_PCIe_RC_INFO: segemnt (%d) is not valid\n", rc_seg_num);
+      return ACS_INVALID_INDEX;
+  }
+
   /* Go through the table to reach a RC with the segment number */
   block = &g_iovirt_info_table->blocks[0];
   for (i = 0; i < g_iovirt_info_table->num_blocks; i++, block = IOVIRT_NEXT_BLOCK(block))
@@ -24,6 +24,21 @@
 #include "include/acs_mpam_reg.h"
 
 static MPAM_INFO_TABLE *g_mpam_info_table;
+static MPAM_MSC_INDEX_ENTRY *g_mpam_msc_index;
+
+/* Read-only ID register words of an MSC kept in its feature snapshot */
+#define MPAM_FEAT_WORD(reg_offset) (1ULL << ((reg_offset) >> 2))
+static const uint64_t g_mpam_feat_words =
+    MPAM_FEAT_WORD(REG_MPAMF_IDR) | MPAM_FEAT_WORD(REG_MPAMF_IDR + 4) |
+    MPAM_FEAT_WORD(REG_MPAMF_IIDR) | MPAM_FEAT_WORD(REG_MPAMF_AIDR) |
+    MPAM_FEAT_WORD(REG_MPAMF_CPOR_IDR) | MPAM_FEAT_WORD(REG_MPAMF_CCAP_IDR) |
+    MPAM_FEAT_WORD(REG_MPAMF_MBW_IDR) | MPAM_FEAT_WORD(REG_MPAMF_PRI_IDR) |
+    MPAM_FEAT_WORD(REG_MPAMF_PARTID_NRW_IDR) | MPAM_FEAT_WORD(REG_MPAMF_MSMON_IDR) |
+    MPAM_FEAT_WORD(REG_MPAMF_CSUMON_IDR) | MPAM_FEAT_WORD(REG_MPAMF_MBWUMON_IDR) |
+    MPAM_FEAT_WORD(REG_MPAMF_MBWUMON_IDR + 4);
+
+static uint32_t val_mpam_pcc_read_regs(uint32_t msc_index, uint32_t num_regs,
+                                       uint32_t *reg_offset, uint32_t *value);
 static SRAT_INFO_TABLE *g_srat_info_table;
 static HMAT_INFO_TABLE *g_hmat_info_table;
 
@@ -80,6 +95,57 @@ val_mpam_reg_write(MPAM_SYS_REGS reg_id, uint64_t write_data)
   return;
 }
 
+/**
+  @brief   This API returns the flat index entry of an MSC node.
+
+  @param   msc_index  - index of the MSC node in the MPAM info table.
+
+  @return  index entry if found, otherwise NULL.
+**/
+static MPAM_MSC_INDEX_ENTRY *
+val_mpam_msc_entry(uint32_t msc_index)
+{
+  if (g_mpam_msc_index == NULL || msc_index >= g_mpam_info_table->msc_count)
+      return NULL;
+
+  return &g_mpam_msc_index[msc_index];
+}
+
+/**
+  @brief   This API builds the flat MSC index over the MPAM info table, caching
+           the fields used on every register access.
+           1. Caller       -  val_mpam_create_info_table
+           2. Prerequisite -  MPAM info table populated by PAL
+  @param   None
+  @return  None
+**/
+static void
+val_mpam_create_msc_index(void)
+{
+  uint32_t i;
+  MPAM_MSC_NODE *msc_entry;
+
+  g_mpam_msc_index = NULL;
+  if (g_mpam_info_table->msc_count == 0)
+      return;
+
+  g_mpam_msc_index = (MPAM_MSC_INDEX_ENTRY *) pal_aligned_alloc(MEM_ALIGN_4K,
+                             g_mpam_info_table->msc_count * sizeof(MPAM_MSC_INDEX_ENTRY));
+  if (g_mpam_msc_index == NULL) {
+      val_print(ACS_PRINT_WARN, "\n   MPAM MSC index allocation failed, using list walk", 0);
+      return;
+  }
+
+  msc_entry = &g_mpam_info_table->msc_node[0];
+  for (i = 0; i < g_mpam_info_table->msc_count; i++, msc_entry = MPAM_NEXT_MSC(msc_entry)) {
+      g_mpam_msc_index[i].msc_node   = msc_entry;
+      g_mpam_msc_index[i].base_addr  = msc_entry->msc_base_addr;
+      g_mpam_msc_index[i].identifier = msc_entry->identifier;
+      g_mpam_msc_index[i].intrf_type = msc_entry->intrf_type;
+      val_memory_set(&g_mpam_msc_index[i].feat, sizeof(MPAM_MSC_FEAT_CACHE), 0);
+  }
+}
+
 /**
   @brief   This API returns requested MSC or resource info.
 
@@ -95,64 +161,69 @@ val_mpam_get_info(MPAM_INFO_e type, uint32_t msc_index, uint32_t rsrc_index)
 {
   uint32_t i = 0;
   MPAM_MSC_NODE *msc_entry;
+  MPAM_MSC_INDEX_ENTRY *index_entry;
 
   if (g_mpam_info_table == NULL) {
       val_print(ACS_PRINT_WARN, "\n   MPAM info table not found", 0);
       return MPAM_INVALID_INFO;
   }
 
-  if (msc_index > g_mpam_info_table->msc_count) {
+  if (msc_index >= g_mpam_info_table->msc_count) {
       val_print(ACS_PRINT_ERR, "Invalid MSC index = 0x%lx ", msc_index);
       return 0;
   }
 
-  /* Walk the MPAM info table and return requested info */
-  msc_entry = &g_mpam_info_table->msc_node[0];
-  for (i = 0; i < g_mpam_info_table->msc_count; i++, msc_entry = MPAM_NEXT_MSC(msc_entry)) {
-      if (msc_index == i) {
-          if (rsrc_index > msc_entry->rsrc_count - 1) {
-              val_print(ACS_PRINT_ERR,
-                      "\n   Invalid MSC resource index = 0x%lx for", rsrc_index);
-              val_print(ACS_PRINT_ERR, "MSC index = 0x%lx ", msc_index);
-              return MPAM_INVALID_INFO;
-          }
-          switch (type) {
-          case MPAM_MSC_RSRC_COUNT:
-              return msc_entry->rsrc_count;
-          case MPAM_MSC_RSRC_RIS:
-              return msc_entry->rsrc_node[rsrc_index].ris_index;
-          case MPAM_MSC_RSRC_TYPE:
-              return msc_entry->rsrc_node[rsrc_index].locator_type;
-          case MPAM_MSC_RSRC_DESC1:
-              return msc_entry->rsrc_node[rsrc_index].descriptor1;
-          case MPAM_MSC_RSRC_DESC2:
-              return msc_entry->rsrc_node[rsrc_index].descriptor2;
-          case MPAM_MSC_BASE_ADDR:
-              return msc_entry->msc_base_addr;
-          case MPAM_MSC_ADDR_LEN:
-              return msc_entry->msc_addr_len;
-          case MPAM_MSC_NRDY:
-              return msc_entry->max_nrdy;
-          case MPAM_MSC_OF_INTR:
-              return msc_entry->of_intr;
-          case MPAM_MSC_OF_INTR_FLAGS:
-              return msc_entry->of_intr_flags;
-          case MPAM_MSC_ERR_INTR:
-              return msc_entry->err_intr;
-          case MPAM_MSC_ERR_INTR_FLAGS:
-              return msc_entry->err_intr_flags;
-          case MPAM_MSC_ID:
-              return msc_entry->identifier;
-          case MPAM_MSC_INTERFACE_TYPE:
-              return msc_entry->intrf_type;
-          default:
-              val_print(ACS_PRINT_ERR,
-                       "\n   This MPAM info option for type %d is not supported", type);
-              return MPAM_INVALID_INFO;
-          }
-      }
+  index_entry = val_mpam_msc_entry(msc_index);
+  if (index_entry != NULL) {
+      msc_entry = index_entry->msc_node;
+  } else {
+      /* No index, walk the MPAM info table to the requested MSC */
+      msc_entry = &g_mpam_info_table->msc_node[0];
+      for (i = 0; i < msc_index; i++)
+          msc_entry = MPAM_NEXT_MSC(msc_entry);
+  }
+
+  if (rsrc_index > msc_entry->rsrc_count - 1) {
+      val_print(ACS_PRINT_ERR,
+              "\n   Invalid MSC resource index = 0x%lx for", rsrc_index);
+      val_print(ACS_PRINT_ERR, "MSC index = 0x%lx ", msc_index);
+      return MPAM_INVALID_INFO;
+  }
+
+  switch (type) {
+  case MPAM_MSC_RSRC_COUNT:
+      return msc_entry->rsrc_count;
+  case MPAM_MSC_RSRC_RIS:
+      return msc_entry->rsrc_node[rsrc_index].ris_index;
+  case MPAM_MSC_RSRC_TYPE:
+      return msc_entry->rsrc_node[rsrc_index].locator_type;
+  case MPAM_MSC_RSRC_DESC1:
+      return msc_entry->rsrc_node[rsrc_index].descriptor1;
+  case MPAM_MSC_RSRC_DESC2:
+      return msc_entry->rsrc_node[rsrc_index].descriptor2;
+  case MPAM_MSC_BASE_ADDR:
+      return msc_entry->msc_base_addr;
+  case MPAM_MSC_ADDR_LEN:
+      return msc_entry->msc_addr_len;
+  case MPAM_MSC_NRDY:
+      return msc_entry->max_nrdy;
+  case MPAM_MSC_OF_INTR:
+      return msc_entry->of_intr;
+  case MPAM_MSC_OF_INTR_FLAGS:
+      return msc_entry->of_intr_flags;
+  case MPAM_MSC_ERR_INTR:
+      return msc_entry->err_intr;
+  case MPAM_MSC_ERR_INTR_FLAGS:
+      return msc_entry->err_intr_flags;
+  case MPAM_MSC_ID:
+      return msc_entry->identifier;
+  case MPAM_MSC_INTERFACE_TYPE:
+      return msc_entry->intrf_type;
+  default:
+      val_print(ACS_PRINT_ERR,
+               "\n   This MPAM info option for type %d is not supported", type);
+      return MPAM_INVALID_INFO;
   }
-  return MPAM_INVALID_INFO;
 }
 
 /**
@@ -720,33 +791,33 @@ uint64_t
 val_mpam_memory_mbwumon_read_count(uint32_t msc_index)
 {
     uint64_t count = MPAM_MON_NOT_READY;
+    uint32_t mbwumon_idr;
+    uint64_t mbwu;
+
+    /* ID register is read once, NRDY and value come from a single counter read */
+    mbwumon_idr = val_mpam_mmr_read(msc_index, REG_MPAMF_MBWUMON_IDR);
 
     /*if MSMON_MBWU_L is implemented*/
-    if (BITFIELD_READ(MBWUMON_IDR_LWD, val_mpam_mmr_read64(msc_index, REG_MPAMF_MBWUMON_IDR))) {
-        if (BITFIELD_READ(MBWUMON_IDR_HAS_LONG,
-            val_mpam_mmr_read64(msc_index, REG_MPAMF_MBWUMON_IDR))) {
+    if (BITFIELD_READ(MBWUMON_IDR_LWD, mbwumon_idr)) {
+        mbwu = val_mpam_mmr_read64(msc_index, REG_MSMON_MBWU_L);
+        if (BITFIELD_READ(MBWUMON_IDR_HAS_LONG, mbwumon_idr)) {
             // (63 bits)
-            if (BITFIELD_READ(MSMON_MBWU_L_NRDY,
-                val_mpam_mmr_read64(msc_index, REG_MSMON_MBWU_L)) == 0)
-                count = BITFIELD_READ(MSMON_MBWU_L_63BIT_VALUE,
-                                      val_mpam_mmr_read64(msc_index, REG_MSMON_MBWU_L));
+            if (BITFIELD_READ(MSMON_MBWU_L_NRDY, mbwu) == 0)
+                count = BITFIELD_READ(MSMON_MBWU_L_63BIT_VALUE, mbwu);
         }
         else {
             // (44 bits)
-            if (BITFIELD_READ(MSMON_MBWU_L_NRDY,
-                val_mpam_mmr_read64(msc_index, REG_MSMON_MBWU_L)) == 0)
-                count = BITFIELD_READ(MSMON_MBWU_L_44BIT_VALUE,
-                                      val_mpam_mmr_read64(msc_index, REG_MSMON_MBWU_L));
+            if (BITFIELD_READ(MSMON_MBWU_L_NRDY, mbwu) == 0)
+                count = BITFIELD_READ(MSMON_MBWU_L_44BIT_VALUE, mbwu);
         }
     }
     else {
         // (31 bits)
-        if (BITFIELD_READ(MSMON_MBWU_NRDY, val_mpam_mmr_read(msc_index, REG_MSMON_MBWU)) == 0) {
-            count = BITFIELD_READ(MSMON_MBWU_VALUE,
-                                  val_mpam_mmr_read(msc_index, REG_MSMON_MBWU));
+        mbwu = val_mpam_mmr_read(msc_index, REG_MSMON_MBWU);
+        if (BITFIELD_READ(MSMON_MBWU_NRDY, mbwu) == 0) {
+            count = BITFIELD_READ(MSMON_MBWU_VALUE, mbwu);
             /* shift the count if scaling is enabled */
-            count = count << BITFIELD_READ(MBWUMON_IDR_SCALE,
-                                  val_mpam_mmr_read(msc_index, REG_MPAMF_MBWUMON_IDR));
+            count = count << BITFIELD_READ(MBWUMON_IDR_SCALE, mbwumon_idr);
         }
     }
     return(count);
@@ -871,6 +942,7 @@ val_mpam_create_info_table(uint64_t *mpam_info_table)
   g_mpam_info_table = (MPAM_INFO_TABLE *)mpam_info_table;
 #ifndef TARGET_LINUX
   pal_mpam_create_info_table(g_mpam_info_table);
+  val_mpam_create_msc_index();
 
   val_print(ACS_PRINT_TEST,
                 " MPAM INFO: Number of MSC nodes       :    %d\n", g_mpam_info_table->msc_count);
@@ -889,6 +961,11 @@ val_mpam_create_info_table(uint64_t *mpam_info_table)
 void
 val_mpam_free_info_table(void)
 {
+    if (g_mpam_msc_index != NULL) {
+        pal_mem_free_aligned((void *)g_mpam_msc_index);
+        g_mpam_msc_index = NULL;
+    }
+
     if (g_mpam_info_table != NULL) {
         pal_mem_free_aligned((void *)g_mpam_info_table);
         g_mpam_info_table = NULL;
@@ -1360,19 +1437,153 @@ val_mpam_csumon_disable(uint32_t msc_index)
 uint32_t
 val_mpam_read_csumon(uint32_t msc_index)
 {
-    uint32_t count;
+    uint32_t csu;
+
+    /* NRDY and value come from a single counter read */
+    csu = val_mpam_mmr_read(msc_index, REG_MSMON_CSU);
+    if (BITFIELD_READ(MSMON_CSU_NRDY, csu) == 0)
+        return BITFIELD_READ(MSMON_CSU_VALUE, csu);
 
-    if (BITFIELD_READ(MSMON_CSU_NRDY, val_mpam_mmr_read(msc_index, REG_MSMON_CSU)) == 0) {
-        count = BITFIELD_READ(MSMON_CSU_VALUE,
-                                      val_mpam_mmr_read(msc_index, REG_MSMON_CSU));
-        return count;
-    }
     return 0;
 }
 
+/**
+  @brief   This API returns the register access details of an MSC, from the
+           flat MSC index when available.
+
+  @param   msc_index  - index of the MSC node in the MPAM info table.
+  @param   base_addr  - MMIO base address or PCC subspace ID of the MSC.
+  @param   msc_id     - MSC identifier used in PCC commands, may be NULL.
+
+  @return  interface type of the MSC.
+**/
+static uint32_t
+val_mpam_msc_access_info(uint32_t msc_index, uint64_t *base_addr, uint32_t *msc_id)
+{
+  MPAM_MSC_INDEX_ENTRY *index_entry;
+
+  index_entry = val_mpam_msc_entry(msc_index);
+  if (index_entry != NULL) {
+      *base_addr = index_entry->base_addr;
+      if (msc_id != NULL)
+          *msc_id = index_entry->identifier;
+      return index_entry->intrf_type;
+  }
+
+  *base_addr = val_mpam_get_info(MPAM_MSC_BASE_ADDR, msc_index, 0);
+  if (msc_id != NULL)
+      *msc_id = val_mpam_get_info(MPAM_MSC_ID, msc_index, 0);
+  return val_mpam_get_info(MPAM_MSC_INTERFACE_TYPE, msc_index, 0);
+}
+
+/**
+  @brief   This API checks whether a register offset is one of the read-only
+           MSC ID register words kept in the feature snapshot.
+
+  @param   reg_offset - Register offset address.
+
+  @return  1 if cacheable, 0 otherwise.
+**/
+static uint32_t
+val_mpam_feat_cacheable(uint32_t reg_offset)
+{
+  uint32_t word = reg_offset >> 2;
+
+  if ((reg_offset & 0x3) || (word >= MPAM_FEAT_CACHE_WORDS))
+      return 0;
+
+  return (g_mpam_feat_words >> word) & 0x1;
+}
+
+/**
+  @brief   This API returns an MSC ID register word from the feature snapshot.
+
+  @param   msc_index  - index of the MSC node in the MPAM info table.
+  @param   reg_offset - Register offset address.
+  @param   value      - Snapshot value of the register word.
+
+  @return  1 if served from the snapshot, 0 if the register must be read.
+**/
+static uint32_t
+val_mpam_feat_cache_get(uint32_t msc_index, uint32_t reg_offset, uint32_t *value)
+{
+  MPAM_MSC_INDEX_ENTRY *index_entry;
+
+  if (!val_mpam_feat_cacheable(reg_offset))
+      return 0;
+
+  index_entry = val_mpam_msc_entry(msc_index);
+  if (index_entry == NULL || !(index_entry->feat.valid & (1ULL << (reg_offset >> 2))))
+      return 0;
+
+  *value = index_entry->feat.word[reg_offset >> 2];
+  return 1;
+}
+
+/**
+  @brief   This API captures an MSC ID register word into the feature snapshot.
+
+  @param   msc_index  - index of the MSC node in the MPAM info table.
+  @param   reg_offset - Register offset address.
+  @param   value      - Value read from the register.
+
+  @return  None
+**/
+static void
+val_mpam_feat_cache_put(uint32_t msc_index, uint32_t reg_offset, uint32_t value)
+{
+  MPAM_MSC_INDEX_ENTRY *index_entry;
+  uint32_t part_sel;
+
+  if (!val_mpam_feat_cacheable(reg_offset))
+      return;
+
+  index_entry = val_mpam_msc_entry(msc_index);
+  if (index_entry == NULL)
+      return;
+
+  /* Learn the selected RIS before the first capture, the snapshot is tagged with it */
+  if (!index_entry->feat.ris_known) {
+      part_sel = val_mpam_mmr_read(msc_index, REG_MPAMCFG_PART_SEL);
+      index_entry->feat.ris = BITFIELD_READ(PART_SEL_RIS, part_sel);
+      index_entry->feat.ris_known = 1;
+  }
+
+  index_entry->feat.word[reg_offset >> 2] = value;
+  index_entry->feat.valid |= (1ULL << (reg_offset >> 2));
+}
+
+/**
+  @brief   This API tracks MPAMCFG_PART_SEL writes, dropping the feature snapshot
+           when a different resource instance gets selected.
+
+  @param   msc_index  - index of the MSC node in the MPAM info table.
+  @param   data       - Value written to MPAMCFG_PART_SEL.
+
+  @return  None
+**/
+static void
+val_mpam_feat_cache_select(uint32_t msc_index, uint32_t data)
+{
+  MPAM_MSC_INDEX_ENTRY *index_entry;
+  uint32_t ris;
+
+  index_entry = val_mpam_msc_entry(msc_index);
+  if (index_entry == NULL)
+      return;
+
+  ris = BITFIELD_READ(PART_SEL_RIS, data);
+  if (!index_entry->feat.ris_known || index_entry->feat.ris != ris) {
+      index_entry->feat.valid = 0;
+      index_entry->feat.ris = ris;
+      index_entry->feat.ris_known = 1;
+  }
+}
+
 /**
   @brief   This API reads 32bit MPAM memory mapped register either
-           via MMIO or PCC interface.
+           via MMIO or PCC interface. ID registers are served from the
+           MSC feature snapshot once captured.
 
   @param   msc_index  - MPAM feature page index for this MSC.
   @param   reg_offset - Register offset address.
@@ -1386,16 +1597,20 @@ val_mpam_mmr_read(uint32_t msc_index, uint32_t reg_offset)
   uint32_t intrf_type;
   uint32_t value;
 
-  base_addr  = val_mpam_get_info(MPAM_MSC_BASE_ADDR, msc_index, 0);
-  intrf_type = val_mpam_get_info(MPAM_MSC_INTERFACE_TYPE, msc_index, 0);
+  if (val_mpam_feat_cache_get(msc_index, reg_offset, &value))
+      return value;
+
+  intrf_type = val_mpam_msc_access_info(msc_index, &base_addr, NULL);
 
   if (intrf_type == MPAM_INTERFACE_TYPE_MMIO) {
       value = val_mmio_read(base_addr + reg_offset);
       val_print(ACS_PRINT_DEBUG, "\n       MPAM Read reg_offset : 0x%x", reg_offset);
       val_print(ACS_PRINT_DEBUG, " value : 0x%llx", value);
+      val_mpam_feat_cache_put(msc_index, reg_offset, value);
       return value;
   } else if (intrf_type == MPAM_INTERFACE_TYPE_PCC) {
-      value = val_mpam_pcc_read(msc_index, reg_offset);
+      if (val_mpam_pcc_read_regs(msc_index, 1, &reg_offset, &value))
+          val_mpam_feat_cache_put(msc_index, reg_offset, value);
       val_print(ACS_PRINT_DEBUG, "\n       MPAM Read reg_offset : 0x%x", reg_offset);
       val_print(ACS_PRINT_DEBUG, " value : 0x%llx", value);
       return value;
@@ -1408,7 +1623,8 @@ val_mpam_mmr_read(uint32_t msc_index, uint32_t reg_offset)
 
 /**
   @brief   This API reads 64bit MPAM memory mapped register either
-           via MMIO or PCC interface.
+           via MMIO or PCC interface. ID registers are served from the
+           MSC feature snapshot once captured.
 
   @param   msc_index  - MPAM feature page index for this MSC.
   @param   reg_offset - Register offset address.
@@ -1421,20 +1637,34 @@ val_mpam_mmr_read64(uint32_t msc_index, uint32_t reg_offset)
   uint64_t base_addr;
   uint32_t intrf_type;
   uint64_t value;
+  uint32_t offset[2];
+  uint32_t word[2];
+  uint32_t read_ok;
 
-  base_addr  = val_mpam_get_info(MPAM_MSC_BASE_ADDR, msc_index, 0);
-  intrf_type = val_mpam_get_info(MPAM_MSC_INTERFACE_TYPE, msc_index, 0);
+  if (val_mpam_feat_cache_get(msc_index, reg_offset, &word[0]) &&
+      val_mpam_feat_cache_get(msc_index, reg_offset + 4, &word[1]))
+      return ((uint64_t)word[1] << 32) | word[0];
+
+  intrf_type = val_mpam_msc_access_info(msc_index, &base_addr, NULL);
 
   if (intrf_type == MPAM_INTERFACE_TYPE_MMIO) {
       value = val_mmio_read64(base_addr + reg_offset);
       val_print(ACS_PRINT_DEBUG, "\n       MPAM Read reg_offset : 0x%x", reg_offset);
       val_print(ACS_PRINT_DEBUG, " value : 0x%llx", value);
+      val_mpam_feat_cache_put(msc_index, reg_offset, (uint32_t)value);
+      val_mpam_feat_cache_put(msc_index, reg_offset + 4, (uint32_t)(value >> 32));
       return value;
   } else if (intrf_type == MPAM_INTERFACE_TYPE_PCC) {
       /* PCC supports only supports 32 bit read at a time, hence reading twice
          and concating */
-      value = ((uint64_t)val_mpam_pcc_read(msc_index, reg_offset + 4) << 32)
-                                | val_mpam_pcc_read(msc_index, reg_offset);
+      offset[0] = reg_offset;
+      offset[1] = reg_offset + 4;
+      read_ok = val_mpam_pcc_read_regs(msc_index, 2, offset, word);
+      if (read_ok == 0x3) {
+          val_mpam_feat_cache_put(msc_index, offset[0], word[0]);
+          val_mpam_feat_cache_put(msc_index, offset[1], word[1]);
+      }
+      value = ((uint64_t)word[1] << 32) | word[0];
       val_print(ACS_PRINT_DEBUG, "\n       MPAM Read reg_offset : 0x%x", reg_offset);
       val_print(ACS_PRINT_DEBUG, " value : 0x%llx", value);
       return value;
@@ -1461,8 +1691,10 @@ val_mpam_mmr_write(uint32_t msc_index, uint32_t reg_offset, uint32_t data)
   uint64_t base_addr;
   uint32_t intrf_type;
 
-  base_addr  = val_mpam_get_info(MPAM_MSC_BASE_ADDR, msc_index, 0);
-  intrf_type = val_mpam_get_info(MPAM_MSC_INTERFACE_TYPE, msc_index, 0);
+  intrf_type = val_mpam_msc_access_info(msc_index, &base_addr, NULL);
+
+  if (reg_offset == REG_MPAMCFG_PART_SEL)
+      val_mpam_feat_cache_select(msc_index, data);
 
   if (intrf_type == MPAM_INTERFACE_TYPE_MMIO) {
       val_mmio_write(base_addr + reg_offset, data);
@@ -1495,8 +1727,10 @@ val_mpam_mmr_write64(uint32_t msc_index, uint32_t reg_offset, uint64_t data)
   uint64_t base_addr;
   uint32_t intrf_type;
 
-  base_addr  = val_mpam_get_info(MPAM_MSC_BASE_ADDR, msc_index, 0);
-  intrf_type = val_mpam_get_info(MPAM_MSC_INTERFACE_TYPE, msc_index, 0);
+  intrf_type = val_mpam_msc_access_info(msc_index, &base_addr, NULL);
+
+  if (reg_offset == REG_MPAMCFG_PART_SEL)
+      val_mpam_feat_cache_select(msc_index, (uint32_t)data);
 
   if (intrf_type == MPAM_INTERFACE_TYPE_MMIO) {
       val_mmio_write64(base_addr + reg_offset, data);
@@ -1514,25 +1748,33 @@ val_mpam_mmr_write64(uint32_t msc_index, uint32_t reg_offset, uint64_t data)
 }
 
 /**
-  @brief   This API constructs header and parameter for the
-           MPAM_MSC_READ PCC command and calls doorbell protocol.
+  @brief   This API sends one MPAM_MSC_READ PCC command per register of an MSC.
+           The subspace, MSC ID and message header are resolved once for all
+           of them; MSC_READ carries a single offset, so each read is its own
+           doorbell.
 
   @param   msc_index  - MPAM feature page index for this MSC.
-  @param   reg_offset - Register offset address.
+  @param   num_regs   - Number of registers to read, at most 32.
+  @param   reg_offset - Register offset addresses.
+  @param   value      - Read values, MPAM_PCC_SAFE_RETURN for failed reads.
 
-  @return  None
+  @return  Bit mask of the reads that completed successfully.
 **/
-uint32_t
-val_mpam_pcc_read(uint32_t msc_index, uint32_t reg_offset)
+static uint32_t
+val_mpam_pcc_read_regs(uint32_t msc_index, uint32_t num_regs, uint32_t *reg_offset,
+                       uint32_t *value)
 {
   SCMI_PROTOCOL_MESSAGE_HEADER header;
   PCC_MPAM_MSC_READ_CMD_PARA parameter;
   PCC_MPAM_MSC_READ_RESP_PARA *response;
-  uint32_t subspace_id;
+  uint64_t subspace_id;
+  uint32_t msc_id;
+  uint32_t read_ok;
+  uint32_t i;
 
   /* if MSC interface type is PCC (0x0A), the Base address field
      captures index to PCCT ACPI structure */
-  subspace_id = (uint32_t)val_mpam_get_info(MPAM_MSC_BASE_ADDR, msc_index, 0);
+  val_mpam_msc_access_info(msc_index, &subspace_id, &msc_id);
 
   /* construct the message header */
   header.reserved = 0;
@@ -1542,25 +1784,51 @@ val_mpam_pcc_read(uint32_t msc_index, uint32_t reg_offset)
   /* token is user defined value for book keeping */
   header.token = 1;
 
-  /* construct parameter payload */
-  parameter.msc_id = val_mpam_get_info(MPAM_MSC_ID, msc_index, 0);
+  parameter.msc_id = msc_id;
   parameter.flags = 0;
-  parameter.offset = reg_offset;
 
-  response = (PCC_MPAM_MSC_READ_RESP_PARA *) val_pcc_cmd_response(
+  read_ok = 0;
+  for (i = 0; i < num_regs; i++) {
+      /* construct parameter payload */
+      parameter.offset = reg_offset[i];
+
+      response = (PCC_MPAM_MSC_READ_RESP_PARA *) val_pcc_cmd_response(
               (uint32_t)subspace_id, *(uint32_t *)&header, (void *)&parameter, sizeof(parameter));
 
-  if (response == NULL || response->status != MPAM_PCC_CMD_SUCCESS) {
-      val_print(ACS_PRINT_ERR,
-                "\n    Failed to read MPAM register with offset (0x%x) via PCC", reg_offset);
-      val_print(ACS_PRINT_ERR, " for MSC index = 0x%x", msc_index);
-      if (response != NULL) {
-          val_print(ACS_PRINT_ERR, "\n    PCC command response code = 0x%x", response->status);
+      if (response == NULL || response->status != MPAM_PCC_CMD_SUCCESS) {
+          val_print(ACS_PRINT_ERR,
+                    "\n    Failed to read MPAM register with offset (0x%x) via PCC", reg_offset[i]);
+          val_print(ACS_PRINT_ERR, " for MSC index = 0x%x", msc_index);
+          if (response != NULL) {
+              val_print(ACS_PRINT_ERR, "\n    PCC command response code = 0x%x", response->status);
+          }
+          value[i] = MPAM_PCC_SAFE_RETURN;
+          continue;
       }
-      return MPAM_PCC_SAFE_RETURN;
-  } else {
-      return response->val;
+
+      value[i] = response->val;
+      read_ok |= (1u << i);
   }
+
+  return read_ok;
+}
+
+/**
+  @brief   This API constructs header and parameter for the
+           MPAM_MSC_READ PCC command and calls doorbell protocol.
+
+  @param   msc_index  - MPAM feature page index for this MSC.
+  @param   reg_offset - Register offset address.
+
+  @return  None
+**/
+uint32_t
+val_mpam_pcc_read(uint32_t msc_index, uint32_t reg_offset)
+{
+  uint32_t value;
+
+  val_mpam_pcc_read_regs(msc_index, 1, &reg_offset, &value);
+  return value;
 }
 
 /**
@@ -1578,11 +1846,12 @@ val_mpam_pcc_write(uint32_t msc_index, uint32_t reg_offset, uint32_t data)
   SCMI_PROTOCOL_MESSAGE_HEADER header;
   PCC_MPAM_MSC_WRITE_CMD_PARA parameter;
   PCC_MPAM_MSC_WRITE_RESP_PARA *response;
-  uint32_t subspace_id;
+  uint64_t subspace_id;
+  uint32_t msc_id;
 
   /* if MSC interface type is PCC (0x0A), the Base address field
      captures index to PCCT ACPI structure */
-  subspace_id = val_mpam_get_info(MPAM_MSC_BASE_ADDR, msc_index, 0);
+  val_mpam_msc_access_info(msc_index, &subspace_id, &msc_id);
 
   /* construct the message header */
   header.reserved = 0;
@@ -1593,7 +1862,7 @@ val_mpam_pcc_write(uint32_t msc_index, uint32_t reg_offset, uint32_t data)
   header.token = 1;
 
   /* construct parameter payload */
-  parameter.msc_id = val_mpam_get_info(MPAM_MSC_ID, msc_index, 0);
+  parameter.msc_id = msc_id;
   parameter.flags = 0;
   parameter.val = data;
   parameter.offset = reg_offset;
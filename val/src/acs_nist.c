@@ -36,6 +36,30 @@ val_nist_generate_rng(uint32_t *rng_buffer)
   return status;
 }
 
+/**
+  @brief   This API fills a buffer with 32 bit random numbers so that callers
+           producing a whole bitstream do not go through the RNG one word at
+           a time.
+  @param   rng_buffer    - Pointer to store the random data.
+  @param   num_words     - Number of 32 bit words to generate.
+
+  @return  success/failure.
+**/
+uint32_t
+val_nist_generate_rng_block(uint32_t *rng_buffer, uint32_t num_words)
+{
+  uint32_t status;
+  uint32_t i;
+
+  for (i = 0; i < num_words; i++) {
+      status = pal_nist_generate_rng(&rng_buffer[i]);
+      if (status != ACS_STATUS_PASS)
+          return status;
+  }
+
+  return ACS_STATUS_PASS;
+}
+
 double
 erf(double x)
 {
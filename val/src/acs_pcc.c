@@ -20,8 +20,28 @@
 #include "include/acs_val.h"
 #include "include/acs_common.h"
 #include "include/val_interface.h"
+#include "include/acs_memory.h"
+#include "include/acs_timer_support.h"
+
+/* Polling backoff bounds and command timeout, in microseconds */
+#define PCC_POLL_MIN_DELAY_US  1
+#define PCC_POLL_MAX_DELAY_US  1000
+#define PCC_CMD_TIMEOUT_US     1000000
+
+/* Runtime state and latency statistics of a PCC subspace */
+typedef struct {
+  uint64_t num_cmds;            /* commands completed */
+  uint64_t num_fails;           /* commands that timed out */
+  uint64_t min_ticks;           /* fastest round trip */
+  uint64_t max_ticks;           /* slowest round trip */
+  uint64_t total_ticks;         /* sum of round trips */
+  uint64_t last_done;           /* counter value at last completion */
+  uint32_t intr_installed;      /* completion interrupt handler installed */
+  volatile uint32_t intr_done;  /* completion interrupt seen for current command */
+} PCC_SS_STATE;
 
 static PCC_INFO_TABLE *g_pcc_info_table;
+static PCC_SS_STATE *g_pcc_ss_state;
 
 /* PCCT related APIs */
 
@@ -41,6 +61,19 @@ val_pcc_create_info_table(uint64_t *pcc_info_table)
 
     pal_pcc_create_info_table(g_pcc_info_table);
 
+    g_pcc_ss_state = NULL;
+    if (g_pcc_info_table->subspace_cnt == 0)
+        return;
+
+    g_pcc_ss_state = (PCC_SS_STATE *)pal_aligned_alloc(MEM_ALIGN_4K,
+                                   g_pcc_info_table->subspace_cnt * sizeof(PCC_SS_STATE));
+    if (g_pcc_ss_state == NULL) {
+        val_print(ACS_PRINT_WARN, "\n PCC latency statistics disabled, allocation failed", 0);
+        return;
+    }
+
+    val_memory_set(g_pcc_ss_state, g_pcc_info_table->subspace_cnt * sizeof(PCC_SS_STATE), 0);
+
     return;
 }
 
@@ -71,6 +104,153 @@ val_pcc_get_ss_info_idx(uint32_t subspace_id)
   return RETURN_FAILURE;
 }
 
+/**
+  @brief  Checks the command complete bit of a PCC subspace.
+
+  @param  ss_type_3  - PCC type 3 subspace info.
+
+  @return 1 if command complete is set, 0 otherwise.
+**/
+static uint32_t
+val_pcc_cmd_complete(PCC_SUBSPACE_TYPE_3 *ss_type_3)
+{
+  return (val_mmio_read(ss_type_3->cmd_complete_chk_reg.addr) &
+                                ss_type_3->cmd_complete_chk_mask) ? 1 : 0;
+}
+
+/**
+  @brief  PCC platform interrupt handler. Flags completion for subspaces with an
+          outstanding command. Every active subspace interrupt is acknowledged
+          and EOIed, including spurious or late ones for completed commands.
+
+  @param  None
+
+  @return None
+**/
+static void
+val_pcc_isr(void)
+{
+  uint32_t i, j;
+  uint64_t ack;
+  PCC_SUBSPACE_TYPE_3 *ss_type_3;
+
+  for (i = 0; i < g_pcc_info_table->subspace_cnt; i++) {
+      if (!g_pcc_ss_state[i].intr_installed)
+          continue;
+
+      ss_type_3 = &(g_pcc_info_table->pcc_info[i].type_spec_info.pcc_ss_type_3);
+      if (!val_gic_get_interrupt_state(ss_type_3->platform_intr))
+          continue;
+
+      if (!g_pcc_ss_state[i].intr_done && val_pcc_cmd_complete(ss_type_3))
+          g_pcc_ss_state[i].intr_done = 1;
+
+      /* acknowledge platform interrupt by performing read/modify/write cycle */
+      if (ss_type_3->platform_intr_ack_reg.addr) {
+          ack = val_mmio_read(ss_type_3->platform_intr_ack_reg.addr);
+          ack = (ack & ss_type_3->platform_intr_ack_preserve) | ss_type_3->platform_intr_ack_set;
+          val_mmio_write(ss_type_3->platform_intr_ack_reg.addr, ack);
+      }
+
+      /* subspaces may share an interrupt, EOI it once */
+      for (j = 0; j < i; j++) {
+          if (g_pcc_ss_state[j].intr_installed &&
+              (g_pcc_info_table->pcc_info[j].type_spec_info.pcc_ss_type_3.platform_intr ==
+               ss_type_3->platform_intr))
+              break;
+      }
+      if (j == i)
+          val_gic_end_of_interrupt(ss_type_3->platform_intr);
+  }
+}
+
+/**
+  @brief  Installs the completion interrupt handler of a PCC subspace, when the
+          PCCT describes a platform interrupt. Polling is used otherwise.
+
+  @param  pcc_idx    - index of the subspace in the PCC info table.
+
+  @return None
+**/
+static void
+val_pcc_setup_intr(uint32_t pcc_idx)
+{
+  PCC_SUBSPACE_TYPE_3 *ss_type_3;
+  INTR_TRIGGER_INFO_TYPE_e trigger;
+
+  ss_type_3 = &(g_pcc_info_table->pcc_info[pcc_idx].type_spec_info.pcc_ss_type_3);
+  if (g_pcc_ss_state[pcc_idx].intr_installed || ss_type_3->platform_intr == 0)
+      return;
+
+  /* Platform interrupt flags bit 1 : interrupt mode, 1 edge triggered, 0 level */
+  trigger = (ss_type_3->platform_intr_flags & 0x2) ? INTR_TRIGGER_INFO_EDGE_RISING :
+                                                     INTR_TRIGGER_INFO_LEVEL_HIGH;
+  val_gic_set_intr_trigger(ss_type_3->platform_intr, trigger);
+
+  if (val_gic_install_isr(ss_type_3->platform_intr, val_pcc_isr)) {
+      val_print(ACS_PRINT_WARN,
+                "\n    PCC completion interrupt 0x%x not installed, polling",
+                ss_type_3->platform_intr);
+      /* Do not retry on every command */
+      ss_type_3->platform_intr = 0;
+      return;
+  }
+
+  g_pcc_ss_state[pcc_idx].intr_installed = 1;
+}
+
+/**
+  @brief  Waits for the command complete bit of a PCC subspace with an
+          exponential polling backoff, bounded by a counter based timeout.
+
+  @param  ss_type_3   - PCC type 3 subspace info.
+  @param  state       - Subspace runtime state, NULL to ignore the completion interrupt.
+  @param  first_delay - Delay in microseconds before the first poll.
+
+  @return 1 when command complete is set, 0 on timeout.
+**/
+static uint32_t
+val_pcc_wait_cmd_complete(PCC_SUBSPACE_TYPE_3 *ss_type_3, PCC_SS_STATE *state,
+                          uint32_t first_delay)
+{
+  uint64_t start;
+  uint64_t freq;
+  uint64_t timeout;
+  uint64_t waited_us;
+  uint32_t delay_us;
+
+  /* allow at least 100 times the nominal latency before giving up */
+  timeout = PCC_CMD_TIMEOUT_US;
+  if ((uint64_t)ss_type_3->nominal_latency_usec * 100 > timeout)
+      timeout = (uint64_t)ss_type_3->nominal_latency_usec * 100;
+
+  /* CNTFRQ_EL0 directly, apps using PCC may not create the timer info table */
+  freq = ArmReadCntFrq();
+
+  if (first_delay)
+      val_time_delay_ms(first_delay);
+
+  start = ArmReadCntPct();
+  waited_us = 0;
+  delay_us = PCC_POLL_MIN_DELAY_US;
+  while (1) {
+      if ((state != NULL && state->intr_done) || val_pcc_cmd_complete(ss_type_3))
+          return 1;
+
+      /* without a counter frequency bound the wait by the sum of the poll delays */
+      if (freq) {
+          if ((ArmReadCntPct() - start) > (timeout * freq) / 1000000)
+              return 0;
+      } else if (waited_us > timeout)
+          return 0;
+
+      val_time_delay_ms(delay_us);
+      waited_us += delay_us;
+      if (delay_us < PCC_POLL_MAX_DELAY_US)
+          delay_us <<= 1;
+  }
+}
+
 /**
   @brief  This API implements ACPI Doorbell protocol.
 
@@ -87,12 +267,18 @@ void
 {
 
   uint32_t pcc_idx;
-  uint32_t loop_cnt;
-  uint32_t cmd_complete;
+  uint32_t notify;
+  uint64_t freq;
+  uint64_t now;
+  uint64_t elapsed;
+  uint64_t turnaround;
+  uint64_t start;
+  uint64_t ticks;
   uint64_t shared_mem_addr;
   uint64_t cmd_complete_upd_reg;
   uint64_t doorbell_val;
   PCC_SUBSPACE_TYPE_3 *ptr_to_pcc_ss_type_3;
+  PCC_SS_STATE *state;
 
 
   /* get pcc info block index */
@@ -105,31 +291,43 @@ void
 
   /* pointer to PCC info */
   ptr_to_pcc_ss_type_3 = &(g_pcc_info_table->pcc_info[pcc_idx].type_spec_info.pcc_ss_type_3);
+  state = (g_pcc_ss_state != NULL) ? &g_pcc_ss_state[pcc_idx] : NULL;
+  freq = ArmReadCntFrq();
 
   /* Note : For information on Doorbell Protocol refer ACPI 6.5 specification; section 14.5 */
 
+  /* honour minimum request turnaround time, counted from the previous completion */
+  if (state != NULL && state->last_done && ptr_to_pcc_ss_type_3->min_req_turnaround_usec) {
+      now = ArmReadCntPct();
+      /* without a counter frequency wait the full turnaround time */
+      elapsed = freq ? ((now - state->last_done) * 1000000) / freq : 0;
+      turnaround = ptr_to_pcc_ss_type_3->min_req_turnaround_usec;
+      if (elapsed < turnaround)
+          val_time_delay_ms(turnaround - elapsed);
+  }
+
   /* ensuring command complete check is set, indicating shared memory
      exclusively owned by OSPM */
-  loop_cnt = 3;
-  do {
-      /* wait for minimum request turnaround time * 3 to provide time for platform */
-      val_time_delay_ms(ptr_to_pcc_ss_type_3->min_req_turnaround_usec);
-      /* read command complete check register */
-      cmd_complete = val_mmio_read(ptr_to_pcc_ss_type_3->cmd_complete_chk_reg.addr) &
-                                ptr_to_pcc_ss_type_3->cmd_complete_chk_mask;
-      loop_cnt--;
-  } while (cmd_complete == 0 || loop_cnt != 0);
-
-  /* if platform not setting complete, return with failure */
-  if (loop_cnt == 0) {
+  if (!val_pcc_wait_cmd_complete(ptr_to_pcc_ss_type_3, NULL, 0)) {
       val_print(ACS_PRINT_ERR,
                 "\n    Platform fails to set command complete reg for PCC subspace id : 0x%x",
                 subspace_id);
+      if (state != NULL)
+          state->num_fails++;
       return NULL;
   }
 
+  notify = 0;
+  if (state != NULL) {
+      val_pcc_setup_intr(pcc_idx);
+      notify = state->intr_installed;
+      state->intr_done = 0;
+  }
+
   /* write command and parameters to PCC shared memory region */
   shared_mem_addr = ptr_to_pcc_ss_type_3->base_addr;
+  /* request a completion interrupt only when a handler is installed */
+  val_mmio_write(shared_mem_addr + PCC_TY3_FLAGS_OFFSET, notify ? PCC_TY3_FLAG_NOTIFY : 0);
   /* write command */
   val_mmio_write(shared_mem_addr + PCC_TY3_CMD_OFFSET, command);
   /* write parameters */
@@ -146,35 +344,80 @@ void
   val_mmio_write(ptr_to_pcc_ss_type_3->cmd_complete_update_reg.addr, cmd_complete_upd_reg);
 
   /* ring doorbell by performing read/modify/write cycle */
+  start = ArmReadCntPct();
   doorbell_val = val_mmio_read(ptr_to_pcc_ss_type_3->doorbell_reg.addr);
   doorbell_val = (doorbell_val & ptr_to_pcc_ss_type_3->doorbell_preserve)
                     | ptr_to_pcc_ss_type_3->doorbell_write;
   val_mmio_write(ptr_to_pcc_ss_type_3->doorbell_reg.addr, doorbell_val);
 
-  /* wait for minimum request turnaround time and poll on the command complete bit for set */
-  loop_cnt = 3;
-  do {
-      /* wait for minimum request turnaround time * 3 to provide time for platform */
-      val_time_delay_ms(ptr_to_pcc_ss_type_3->min_req_turnaround_usec);
-      /* read command complete check register */
-      cmd_complete = val_mmio_read(ptr_to_pcc_ss_type_3->cmd_complete_chk_reg.addr) &
-                                ptr_to_pcc_ss_type_3->cmd_complete_chk_mask;
-      loop_cnt--;
-  } while (cmd_complete == 0 || loop_cnt != 0);
-
-  /* if platform not setting complete, return with failure */
-  if (loop_cnt == 0) {
+  /* give the platform its nominal latency, then poll on the command complete bit */
+  if (!val_pcc_wait_cmd_complete(ptr_to_pcc_ss_type_3, state,
+                                 ptr_to_pcc_ss_type_3->nominal_latency_usec)) {
       val_print(ACS_PRINT_ERR,
           "\n    Platform fails to set command complete, post command for PCC subspace id : 0x%x",
           subspace_id);
+      if (state != NULL)
+          state->num_fails++;
       return NULL;
   }
 
+  if (state != NULL) {
+      state->last_done = ArmReadCntPct();
+      ticks = state->last_done - start;
+      if (state->num_cmds == 0 || ticks < state->min_ticks)
+          state->min_ticks = ticks;
+      if (ticks > state->max_ticks)
+          state->max_ticks = ticks;
+      state->total_ticks += ticks;
+      state->num_cmds++;
+  }
+
   /* process response from platform */
   /* return pointer to communication subspace with response data */
   return (void *)(shared_mem_addr + PCC_TY3_COMM_SPACE);
 }
 
+/**
+  @brief  Prints the round trip latency statistics of the PCC subspaces used
+          during the run.
+
+  @param  None
+
+  @return None
+**/
+void
+val_pcc_report_stats(void)
+{
+  uint32_t i;
+  uint64_t freq;
+  PCC_SS_STATE *state;
+
+  if (g_pcc_info_table == NULL || g_pcc_ss_state == NULL)
+      return;
+
+  freq = ArmReadCntFrq();
+  if (freq == 0)
+      return;
+
+  for (i = 0; i < g_pcc_info_table->subspace_cnt; i++) {
+      state = &g_pcc_ss_state[i];
+      if (state->num_cmds == 0 && state->num_fails == 0)
+          continue;
+
+      val_print(ACS_PRINT_TEST, "\n PCC subspace 0x%x latency (us)",
+                g_pcc_info_table->pcc_info[i].subspace_idx);
+      val_print(ACS_PRINT_TEST, " : commands %ld", state->num_cmds);
+      if (state->num_cmds) {
+          val_print(ACS_PRINT_TEST, ", min %ld", (state->min_ticks * 1000000) / freq);
+          val_print(ACS_PRINT_TEST, ", avg %ld",
+                    ((state->total_ticks / state->num_cmds) * 1000000) / freq);
+          val_print(ACS_PRINT_TEST, ", max %ld", (state->max_ticks * 1000000) / freq);
+      }
+      if (state->num_fails)
+          val_print(ACS_PRINT_TEST, ", timeouts %ld", state->num_fails);
+  }
+}
+
 /**
   @brief  Free the memory allocated for the pcc_info_table
 
@@ -185,6 +428,19 @@ void
 void
 val_pcc_free_info_table(void)
 {
+    uint32_t i;
+
+    val_pcc_report_stats();
+
+    if (g_pcc_ss_state != NULL) {
+        for (i = 0; i < g_pcc_info_table->subspace_cnt; i++) {
+            if (g_pcc_ss_state[i].intr_installed)
+                val_gic_free_irq(
+                    g_pcc_info_table->pcc_info[i].type_spec_info.pcc_ss_type_3.platform_intr, 0);
+        }
+        pal_mem_free_aligned((void *)g_pcc_ss_state);
+        g_pcc_ss_state = NULL;
+    }
 
     if (g_pcc_info_table != NULL) {
         pal_mem_free_aligned((void *)g_pcc_info_table);
@@ -22,17 +22,149 @@
 #include "include/acs_pcie.h"
 #include "include/acs_memory.h"
 #include "driver/pcie/pcie.h"
+#ifndef TARGET_LINUX
+#include "include/acs_timer_support.h"
+#endif
 
 #define WARN_STR_LEN 7
 
 pcie_bdf_list_t *pcie_pheripherals_bdf_list = NULL;
 PCIE_INFO_TABLE *g_pcie_info_table;
 pcie_device_bdf_table *g_pcie_bdf_table;
+static pcie_cfg_shadow_table *g_pcie_cfg_shadow;
+
+/* Segment/Bus to ECAM base lookup, built once from the PCIe info table */
+static uint16_t g_pcie_ecam_seg_index[PCIE_ECAM_LOOKUP_MAX_SEG];
+static uint32_t g_pcie_ecam_num_seg;
+static addr_t  *g_pcie_ecam_lookup;
+
+/* Parent, Root Port and downstream Function index of the BDF table */
+static pcie_topology_index *g_pcie_topology;
 
 uint32_t pcie_bdf_table_list_flag;
 uint32_t g_pcie_integrated_devices;
 uint64_t pal_get_mcfg_ptr(void);
 
+/**
+  @brief   Returns the ECAM base of the region decoding the input segment and
+           bus by walking all ECAM regions of the PCIe info table.
+  @param   segment - PCIe segment number
+  @param   bus     - PCIe bus number
+
+  @return  ECAM base address, 0 if no region decodes the bus
+**/
+static addr_t
+val_pcie_ecam_base_scan(uint32_t segment, uint32_t bus)
+{
+  uint32_t i;
+  uint32_t num_ecam;
+
+  num_ecam = (uint32_t)val_pcie_get_info(PCIE_INFO_NUM_ECAM, 0);
+  for (i = 0; i < num_ecam; i++)
+  {
+      if ((bus >= (uint32_t)val_pcie_get_info(PCIE_INFO_START_BUS, i)) &&
+           (bus <= (uint32_t)val_pcie_get_info(PCIE_INFO_END_BUS, i)) &&
+           (segment == (uint32_t)val_pcie_get_info(PCIE_INFO_SEGMENT, i)))
+          return val_pcie_get_info(PCIE_INFO_ECAM, i);
+  }
+
+  return 0;
+}
+
+/**
+  @brief   Returns the ECAM base of the region decoding the input segment and
+           bus. Uses the lookup table when present, else scans ECAM regions.
+           1. Caller       -  Validation layer
+           2. Prerequisite -  val_pcie_create_info_table
+  @param   segment - PCIe segment number
+  @param   bus     - PCIe bus number
+
+  @return  ECAM base address, 0 if no region decodes the bus
+**/
+static addr_t
+val_pcie_ecam_base(uint32_t segment, uint32_t bus)
+{
+  uint32_t seg_index;
+
+  if (g_pcie_ecam_lookup == NULL)
+      return val_pcie_ecam_base_scan(segment, bus);
+
+  if (segment >= PCIE_ECAM_LOOKUP_MAX_SEG)
+      return 0;
+
+  seg_index = g_pcie_ecam_seg_index[segment];
+  if (seg_index == PCIE_ECAM_LOOKUP_NO_SEG)
+      return 0;
+
+  return g_pcie_ecam_lookup[(seg_index * PCIE_MAX_BUS) + bus];
+}
+
+/**
+  @brief   Builds the segment/bus to ECAM base lookup table from the PCIe
+           info table. On allocation failure, config accesses fall back to
+           scanning the ECAM regions.
+           1. Caller       -  val_pcie_create_info_table
+  @param   None
+
+  @return  None
+**/
+static void
+val_pcie_create_ecam_lookup(void)
+{
+  uint32_t i;
+  uint32_t bus;
+  uint32_t segment;
+  uint32_t num_ecam;
+  uint32_t num_seg;
+  uint32_t start_bus;
+  uint32_t end_bus;
+  uint32_t slot;
+
+  num_ecam = (uint32_t)val_pcie_get_info(PCIE_INFO_NUM_ECAM, 0);
+  /* All 0xFF bytes marks every segment as PCIE_ECAM_LOOKUP_NO_SEG */
+  val_memory_set(g_pcie_ecam_seg_index, sizeof(g_pcie_ecam_seg_index), 0xFF);
+
+  /* Assign a row of the lookup table to each segment */
+  num_seg = 0;
+  for (i = 0; i < num_ecam; i++)
+  {
+      segment = (uint32_t)val_pcie_get_info(PCIE_INFO_SEGMENT, i);
+      if (segment >= PCIE_ECAM_LOOKUP_MAX_SEG) {
+          val_print(ACS_PRINT_WARN, "\n       ECAM segment 0x%x out of lookup range", segment);
+          return;
+      }
+
+      if (g_pcie_ecam_seg_index[segment] == PCIE_ECAM_LOOKUP_NO_SEG)
+          g_pcie_ecam_seg_index[segment] = num_seg++;
+  }
+
+  g_pcie_ecam_num_seg = num_seg;
+
+  g_pcie_ecam_lookup = (addr_t *) pal_aligned_alloc(MEM_ALIGN_4K,
+                                                    num_seg * PCIE_MAX_BUS * sizeof(addr_t));
+  if (g_pcie_ecam_lookup == NULL) {
+      val_print(ACS_PRINT_WARN, "\n       ECAM lookup allocation failed, scanning regions", 0);
+      return;
+  }
+
+  val_memory_set(g_pcie_ecam_lookup, num_seg * PCIE_MAX_BUS * sizeof(addr_t), 0);
+
+  /* First region decoding a bus wins, same as a linear scan would */
+  for (i = 0; i < num_ecam; i++)
+  {
+      segment = (uint32_t)val_pcie_get_info(PCIE_INFO_SEGMENT, i);
+      start_bus = (uint32_t)val_pcie_get_info(PCIE_INFO_START_BUS, i);
+      end_bus = (uint32_t)val_pcie_get_info(PCIE_INFO_END_BUS, i);
+
+      for (bus = start_bus; (bus <= end_bus) && (bus < PCIE_MAX_BUS); bus++)
+      {
+          slot = (g_pcie_ecam_seg_index[segment] * PCIE_MAX_BUS) + bus;
+          if (g_pcie_ecam_lookup[slot] == 0)
+              g_pcie_ecam_lookup[slot] = val_pcie_get_info(PCIE_INFO_ECAM, i);
+      }
+  }
+}
+
 /**
   @brief   This API reads 32-bit data from PCIe config space pointed by Bus,
            Device, Function and register offset.
@@ -53,7 +185,6 @@ val_pcie_read_cfg(uint32_t bdf, uint32_t offset, uint32_t *data)
   uint32_t segment = PCIE_EXTRACT_BDF_SEG(bdf);
   uint32_t cfg_addr;
   addr_t   ecam_base = 0;
-  uint32_t i = 0;
 
   if ((bus >= PCIE_MAX_BUS) || (dev >= PCIE_MAX_DEV) || (func >= PCIE_MAX_FUNC)) {
      val_print(ACS_PRINT_ERR, "\n       Invalid Bus/Dev/Func  %x", bdf);
@@ -65,17 +196,7 @@ val_pcie_read_cfg(uint32_t bdf, uint32_t offset, uint32_t *data)
       return PCIE_NO_MAPPING;
   }
 
-  while (i < (uint32_t)val_pcie_get_info(PCIE_INFO_NUM_ECAM, 0))
-  {
-
-      if ((bus >= (uint32_t)val_pcie_get_info(PCIE_INFO_START_BUS, i)) &&
-           (bus <= (uint32_t)val_pcie_get_info(PCIE_INFO_END_BUS, i)) &&
-           (segment == (uint32_t)val_pcie_get_info(PCIE_INFO_SEGMENT, i))) {
-          ecam_base = val_pcie_get_info(PCIE_INFO_ECAM, i);
-          break;
-      }
-      i++;
-  }
+  ecam_base = val_pcie_ecam_base(segment, bus);
 
   if (ecam_base == 0) {
       val_print(ACS_PRINT_ERR, "\n       PCIe_CFG_RD ECAM Base is zero %.8x", bdf);
@@ -108,6 +229,264 @@ val_pcie_io_read_cfg(uint32_t bdf, uint32_t offset, uint32_t *data)
     return pal_pcie_io_read_cfg(bdf, offset, data);
 }
 
+/**
+  @brief   Returns the config space shadow entry of a Function.
+           1. Caller       -  Validation layer
+           2. Prerequisite -  val_pcie_create_device_bdf_table
+  @param   bdf    - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+
+  @return  Pointer to the shadow entry, NULL if the Function is not shadowed
+**/
+static pcie_cfg_shadow_entry *
+val_pcie_cfg_shadow_lookup(uint32_t bdf)
+{
+  uint32_t low;
+  uint32_t high;
+  uint32_t mid;
+
+  if (g_pcie_cfg_shadow == NULL)
+      return NULL;
+
+  /* Entries are kept sorted on bdf */
+  low = 0;
+  high = g_pcie_cfg_shadow->num_entries;
+  while (low < high)
+  {
+      mid = low + (high - low) / 2;
+      if (g_pcie_cfg_shadow->entry[mid].bdf == bdf)
+          return &g_pcie_cfg_shadow->entry[mid];
+
+      if (g_pcie_cfg_shadow->entry[mid].bdf < bdf)
+          low = mid + 1;
+      else
+          high = mid;
+  }
+
+  return NULL;
+}
+
+/**
+  @brief   Captures the config header and capability lists of a Function into
+           the config space shadow.
+           1. Caller       -  val_pcie_create_device_bdf_table
+  @param   bdf    - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+
+  @return  None
+**/
+static void
+val_pcie_cfg_shadow_capture(uint32_t bdf)
+{
+  uint32_t index;
+  uint32_t offset;
+  uint32_t reg_value;
+  pcie_cfg_shadow_entry *entry;
+
+  if (g_pcie_cfg_shadow == NULL)
+      return;
+
+  if ((g_pcie_cfg_shadow->num_entries >= PCIE_CFG_SHADOW_MAX_ENTRIES) ||
+      (val_pcie_cfg_shadow_lookup(bdf) != NULL))
+      return;
+
+  /* Make room for the new entry at its sorted position */
+  index = g_pcie_cfg_shadow->num_entries;
+  while ((index > 0) && (g_pcie_cfg_shadow->entry[index - 1].bdf > bdf))
+  {
+      g_pcie_cfg_shadow->entry[index] = g_pcie_cfg_shadow->entry[index - 1];
+      index--;
+  }
+
+  entry = &g_pcie_cfg_shadow->entry[index];
+  val_memory_set(entry, sizeof(pcie_cfg_shadow_entry), 0);
+  entry->bdf = bdf;
+
+  for (index = 0; index < (PCIE_CFG_SHADOW_HDR_SZ / 4); index++)
+      val_pcie_read_cfg(bdf, index * 4, &entry->header[index]);
+
+  /* Walk the capability list, same as val_pcie_find_capability does */
+  entry->cap_complete = 1;
+  offset = entry->header[TYPE01_CPR / 4] & TYPE01_CPR_MASK;
+  while (offset)
+  {
+      if (entry->num_cap == PCIE_CFG_SHADOW_MAX_CAP) {
+          entry->cap_complete = 0;
+          break;
+      }
+
+      val_pcie_read_cfg(bdf, offset, &reg_value);
+      entry->cap[entry->num_cap].id = reg_value & PCIE_CIDR_MASK;
+      entry->cap[entry->num_cap].offset = offset;
+      entry->num_cap++;
+
+      if (((reg_value & PCIE_CIDR_MASK) == CID_PCIECS) && (entry->pciecs_base == 0)) {
+          entry->pciecs_base = offset;
+          entry->pciecs_value = reg_value;
+      }
+
+      offset = (reg_value >> PCIE_NCPR_SHIFT) & PCIE_NCPR_MASK;
+  }
+
+  /* Walk the extended capability list */
+  entry->ecap_complete = 1;
+  offset = PCIE_ECAP_START;
+  while (offset)
+  {
+      if (entry->num_ecap == PCIE_CFG_SHADOW_MAX_ECAP) {
+          entry->ecap_complete = 0;
+          break;
+      }
+
+      val_pcie_read_cfg(bdf, offset, &reg_value);
+      entry->ecap[entry->num_ecap].id = reg_value & PCIE_ECAP_CIDR_MASK;
+      entry->ecap[entry->num_ecap].offset = offset;
+      entry->num_ecap++;
+
+      offset = (reg_value >> PCIE_ECAP_NCPR_SHIFT) & PCIE_ECAP_NCPR_MASK;
+  }
+
+  g_pcie_cfg_shadow->num_entries++;
+}
+
+/**
+  @brief   Reads a config header register, from the config space shadow if the
+           Function is shadowed. Only meant for fields that software cannot
+           alter other than through val_pcie_write_cfg.
+  @param   bdf    - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+  @param   offset - Register offset within the config header
+  @param   *data  - 32-bit data read
+
+  @return  success/failure
+**/
+static uint32_t
+val_pcie_cfg_shadow_read(uint32_t bdf, uint32_t offset, uint32_t *data)
+{
+  pcie_cfg_shadow_entry *entry;
+
+  entry = val_pcie_cfg_shadow_lookup(bdf);
+  if ((entry == NULL) || (offset >= PCIE_CFG_SHADOW_HDR_SZ))
+      return val_pcie_read_cfg(bdf, offset, data);
+
+  *data = entry->header[offset / 4];
+  return 0;
+}
+
+/**
+  @brief   Refreshes the shadowed register of a Function after a config write.
+  @param   bdf    - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+  @param   offset - Register offset that was written
+
+  @return  None
+**/
+static void
+val_pcie_cfg_shadow_update(uint32_t bdf, uint32_t offset)
+{
+  pcie_cfg_shadow_entry *entry;
+
+  entry = val_pcie_cfg_shadow_lookup(bdf);
+  if (entry == NULL)
+      return;
+
+  /* Re-read rather than store the written data, RO and RW1C bits may differ */
+  offset &= ~WORD_ALIGN_MASK;
+  if (offset < PCIE_CFG_SHADOW_HDR_SZ)
+      val_pcie_read_cfg(bdf, offset, &entry->header[offset / 4]);
+  else if ((entry->pciecs_base != 0) && (offset == entry->pciecs_base))
+      val_pcie_read_cfg(bdf, offset, &entry->pciecs_value);
+}
+
+/**
+  @brief   Returns the topology index entry of a segment and bus.
+  @param   seg    - PCIe segment number
+  @param   bus    - PCIe bus number
+
+  @return  Pointer to the bus entry, NULL if the segment/bus is not indexed
+**/
+static pcie_topology_bus *
+val_pcie_topology_bus(uint32_t seg, uint32_t bus)
+{
+  uint32_t seg_index;
+
+  if ((g_pcie_topology == NULL) || (seg >= PCIE_ECAM_LOOKUP_MAX_SEG) || (bus >= PCIE_MAX_BUS))
+      return NULL;
+
+  seg_index = g_pcie_ecam_seg_index[seg];
+  if (seg_index == PCIE_ECAM_LOOKUP_NO_SEG)
+      return NULL;
+
+  return &g_pcie_topology->bus[(seg_index * PCIE_MAX_BUS) + bus];
+}
+
+/**
+  @brief   Returns BDF table index of the first downstream Function within a
+           bus range, Type 0 Functions first followed by Type 1 Functions.
+  @param   seg     - PCIe segment number
+  @param   sec_bus - Secondary bus number of the bridge
+  @param   sub_bus - Subordinate bus number of the bridge
+
+  @return  BDF table index, PCIE_TOPOLOGY_NO_INDEX if no Function is found
+**/
+static uint32_t
+val_pcie_topology_dsf(uint32_t seg, uint32_t sec_bus, uint32_t sub_bus)
+{
+  uint32_t bus;
+  uint32_t type0_index;
+  uint32_t any_index;
+  pcie_topology_bus *slot;
+
+  type0_index = PCIE_TOPOLOGY_NO_INDEX;
+  any_index = PCIE_TOPOLOGY_NO_INDEX;
+
+  /* Lowest table index wins, same order as a walk of the BDF table */
+  for (bus = sec_bus; bus <= sub_bus; bus++)
+  {
+      slot = val_pcie_topology_bus(seg, bus);
+      if (slot == NULL)
+          break;
+
+      if (slot->first_type0 < type0_index)
+          type0_index = slot->first_type0;
+      if (slot->first < any_index)
+          any_index = slot->first;
+  }
+
+  return (type0_index != PCIE_TOPOLOGY_NO_INDEX) ? type0_index : any_index;
+}
+
+/**
+  @brief   Frees the BDF topology index. Queries fall back to walking the BDF
+           table, used once bridge bus numbers are reprogrammed.
+  @param   None
+
+  @return  None
+**/
+static void
+val_pcie_topology_invalidate(void)
+{
+  if (g_pcie_topology == NULL)
+      return;
+
+  pal_mem_free_aligned((void *)g_pcie_topology);
+  g_pcie_topology = NULL;
+}
+
+/**
+  @brief   Keeps the config space shadow and the topology index coherent with
+           a config write.
+  @param   bdf    - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+  @param   offset - Register offset that was written
+
+  @return  None
+**/
+static void
+val_pcie_cfg_write_done(uint32_t bdf, uint32_t offset)
+{
+  val_pcie_cfg_shadow_update(bdf, offset);
+
+  if ((g_pcie_topology != NULL) && ((offset & ~WORD_ALIGN_MASK) == TYPE1_PBN) &&
+      (val_pcie_function_header_type(bdf) == TYPE1_HEADER))
+      val_pcie_topology_invalidate();
+}
+
 /**
   @brief   This API writes 32-bit data to PCIe config space pointed by Bus,
            Device, Function and register offset.
@@ -128,7 +507,6 @@ val_pcie_write_cfg(uint32_t bdf, uint32_t offset, uint32_t data)
   uint32_t segment  = PCIE_EXTRACT_BDF_SEG(bdf);
   uint32_t cfg_addr;
   addr_t   ecam_base = 0;
-  uint32_t i = 0;
 
 
   if ((bus >= PCIE_MAX_BUS) || (dev >= PCIE_MAX_DEV) || (func >= PCIE_MAX_FUNC)) {
@@ -141,17 +519,7 @@ val_pcie_write_cfg(uint32_t bdf, uint32_t offset, uint32_t data)
       return;
   }
 
-  while (i < (uint32_t)val_pcie_get_info(PCIE_INFO_NUM_ECAM, 0))
-  {
-
-      if ((bus >= (uint32_t)val_pcie_get_info(PCIE_INFO_START_BUS, i)) &&
-           (bus <= (uint32_t)val_pcie_get_info(PCIE_INFO_END_BUS, i)) &&
-           (segment == (uint32_t)val_pcie_get_info(PCIE_INFO_SEGMENT, i))) {
-          ecam_base = val_pcie_get_info(PCIE_INFO_ECAM, i);
-          break;
-      }
-      i++;
-  }
+  ecam_base = val_pcie_ecam_base(segment, bus);
 
   if (ecam_base == 0) {
       val_print(ACS_PRINT_ERR, "\n       PCIe_CFG_WR ECAM Base is zero %.8x", bdf);
@@ -164,6 +532,8 @@ val_pcie_write_cfg(uint32_t bdf, uint32_t offset, uint32_t data)
 
   pal_mmio_write(ecam_base + cfg_addr + offset, data);
   val_mem_issue_dsb();
+
+  val_pcie_cfg_write_done(bdf, offset);
 }
 
 /**
@@ -182,6 +552,7 @@ val_pcie_io_write_cfg(uint32_t bdf, uint32_t offset, uint32_t data)
 {
     pal_pcie_io_write_cfg(bdf, offset, data);
     val_mem_issue_dsb();
+    val_pcie_cfg_write_done(bdf, offset);
     return;
 }
 
@@ -234,9 +605,7 @@ uint64_t val_pcie_get_bdf_config_addr(uint32_t bdf)
   uint32_t func     = PCIE_EXTRACT_BDF_FUNC(bdf);
   uint32_t segment  = PCIE_EXTRACT_BDF_SEG(bdf);
   uint32_t cfg_addr;
-  uint32_t num_ecam;
   addr_t   ecam_base = 0;
-  uint32_t i = 0;
 
   if ((bus >= PCIE_MAX_BUS) || (dev >= PCIE_MAX_DEV) || (func >= PCIE_MAX_FUNC)) {
      val_print(ACS_PRINT_ERR, "\n       Invalid Bus/Dev/Func  %x", bdf);
@@ -248,18 +617,7 @@ uint64_t val_pcie_get_bdf_config_addr(uint32_t bdf)
       return 0;
   }
 
-  num_ecam = (uint32_t)val_pcie_get_info(PCIE_INFO_NUM_ECAM, 0);
-  while (i < num_ecam)
-  {
-
-      if ((bus >= (uint32_t)val_pcie_get_info(PCIE_INFO_START_BUS, i)) &&
-           (bus <= (uint32_t)val_pcie_get_info(PCIE_INFO_END_BUS, i)) &&
-           (segment == (uint32_t)val_pcie_get_info(PCIE_INFO_SEGMENT, i))) {
-          ecam_base = val_pcie_get_info(PCIE_INFO_ECAM, i);
-          break;
-      }
-      i++;
-  }
+  ecam_base = val_pcie_ecam_base(segment, bus);
 
   if (ecam_base == 0) {
       val_print(ACS_PRINT_ERR, "\n       BDF config Read PCIe_CFG: ECAM Base is zero %x", bdf);
@@ -461,6 +819,8 @@ val_pcie_create_info_table(uint64_t *pcie_info_table)
   if (num_ecam == 0)
       return;
 
+  val_pcie_create_ecam_lookup();
+
   val_pcie_enumerate();
 
   /* Create the list of valid Pcie Device Functions */
@@ -476,6 +836,145 @@ val_pcie_create_info_table(uint64_t *pcie_info_table)
   }
 
   val_pcie_print_device_info();
+
+  if (g_print_level <= ACS_PRINT_DEBUG)
+      val_pcie_cfg_access_benchmark(PCIE_CFG_BENCHMARK_ACCESSES);
+}
+
+/**
+  @brief   Reports config accesses per second with the ECAM region scan and
+           with the segment/bus lookup table, reading Vendor ID of first BDF.
+           1. Caller       -  Validation layer
+           2. Prerequisite -  val_pcie_create_device_bdf_table
+  @param   num_access - Number of config reads timed for each path
+
+  @return  None
+**/
+void
+val_pcie_cfg_access_benchmark(uint32_t num_access)
+{
+#ifndef TARGET_LINUX
+  uint32_t i;
+  uint32_t bdf;
+  uint32_t reg_value;
+  uint64_t freq;
+  uint64_t start;
+  uint64_t ticks;
+  addr_t   *ecam_lookup;
+
+  if ((g_pcie_bdf_table == NULL) || (g_pcie_bdf_table->num_entries == 0) ||
+      (g_pcie_ecam_lookup == NULL) || (num_access == 0))
+      return;
+
+  freq = val_get_counter_frequency();
+  bdf = g_pcie_bdf_table->device[0].bdf;
+  ecam_lookup = g_pcie_ecam_lookup;
+
+  /* Time the ECAM region scan by hiding the lookup table */
+  g_pcie_ecam_lookup = NULL;
+  start = ArmReadCntPct();
+  for (i = 0; i < num_access; i++)
+      val_pcie_read_cfg(bdf, TYPE01_VIDR, &reg_value);
+  ticks = ArmReadCntPct() - start;
+  g_pcie_ecam_lookup = ecam_lookup;
+
+  if (ticks)
+      val_print(ACS_PRINT_DEBUG, " PCIE_INFO: Cfg reads/s, ECAM scan    : %ld\n",
+                (num_access * freq) / ticks);
+
+  start = ArmReadCntPct();
+  for (i = 0; i < num_access; i++)
+      val_pcie_read_cfg(bdf, TYPE01_VIDR, &reg_value);
+  ticks = ArmReadCntPct() - start;
+
+  if (ticks)
+      val_print(ACS_PRINT_DEBUG, " PCIE_INFO: Cfg reads/s, ECAM lookup  : %ld\n",
+                (num_access * freq) / ticks);
+#else
+  (void) num_access;
+#endif
+}
+
+/**
+  @brief  Builds the topology index of the BDF table. For every segment/bus it
+          records the directly attached and the enclosing Root Port and the first
+          Functions, so rootport and downstream Function queries need no config
+          reads.
+          On allocation failure queries walk the BDF table instead.
+
+  @param  None
+  @return None
+**/
+static void
+val_pcie_create_topology_index(void)
+{
+  uint32_t index;
+  uint32_t bdf;
+  uint32_t seg;
+  uint32_t bus;
+  uint32_t sec_bus;
+  uint32_t sub_bus;
+  uint32_t dp_type;
+  uint32_t reg_value;
+  uint32_t num_entries;
+  uint32_t bus_tbl_sz;
+  pcie_topology_bus *slot;
+
+  num_entries = g_pcie_bdf_table->num_entries;
+  if ((g_pcie_ecam_num_seg == 0) || (num_entries >= PCIE_TOPOLOGY_NO_INDEX))
+      return;
+
+  bus_tbl_sz = g_pcie_ecam_num_seg * PCIE_MAX_BUS * sizeof(pcie_topology_bus);
+  g_pcie_topology = (pcie_topology_index *) pal_aligned_alloc(MEM_ALIGN_4K,
+                                              sizeof(pcie_topology_index) + bus_tbl_sz);
+  if (g_pcie_topology == NULL) {
+      val_print(ACS_PRINT_WARN, "\n       PCIe topology index allocation failed", 0);
+      return;
+  }
+
+  /* All 0xFF bytes marks every field as PCIE_TOPOLOGY_NO_INDEX */
+  val_memory_set(g_pcie_topology->bus, bus_tbl_sz, 0xFF);
+  g_pcie_topology->num_entries = num_entries;
+
+  /* Walk in table order, the first entry matching a bus wins as in a table walk */
+  for (index = 0; index < num_entries; index++)
+  {
+      bdf = g_pcie_bdf_table->device[index].bdf;
+      seg = PCIE_EXTRACT_BDF_SEG(bdf);
+
+      slot = val_pcie_topology_bus(seg, PCIE_EXTRACT_BDF_BUS(bdf));
+      if (slot == NULL)
+          continue;
+
+      if (slot->first == PCIE_TOPOLOGY_NO_INDEX)
+          slot->first = index;
+
+      if (val_pcie_function_header_type(bdf) == TYPE0_HEADER)
+      {
+          if (slot->first_type0 == PCIE_TOPOLOGY_NO_INDEX)
+              slot->first_type0 = index;
+          continue;
+      }
+
+      val_pcie_cfg_shadow_read(bdf, TYPE1_PBN, &reg_value);
+      sec_bus = ((reg_value >> SECBN_SHIFT) & SECBN_MASK);
+      sub_bus = ((reg_value >> SUBBN_SHIFT) & SUBBN_MASK);
+
+      dp_type = val_pcie_device_port_type(bdf);
+      if ((dp_type != RP) && (dp_type != iEP_RP))
+          continue;
+
+      slot = val_pcie_topology_bus(seg, sec_bus);
+      if ((slot != NULL) && (slot->parent_rp == PCIE_TOPOLOGY_NO_INDEX) && (sec_bus <= sub_bus))
+          slot->parent_rp = index;
+
+      for (bus = sec_bus; bus <= sub_bus; bus++)
+      {
+          slot = val_pcie_topology_bus(seg, bus);
+          if ((slot != NULL) && (slot->rootport == PCIE_TOPOLOGY_NO_INDEX))
+              slot->rootport = index;
+      }
+  }
 }
 
 /**
@@ -526,6 +1025,7 @@ val_pcie_create_device_bdf_table()
   uint32_t bus_index;
   uint32_t dev_index;
   uint32_t func_index;
+  uint32_t num_func;
   uint32_t ecam_index;
   uint32_t bdf;
   uint32_t reg_value;
@@ -551,6 +1051,17 @@ val_pcie_create_device_bdf_table()
   g_pcie_bdf_table->num_entries = 0;
   g_pcie_integrated_devices = 0;
 
+#if PCIE_CFG_SHADOW_ENABLE
+  /* Config space shadow is an optimisation, continue without it on failure */
+  g_pcie_cfg_shadow = (pcie_cfg_shadow_table *) pal_aligned_alloc(MEM_ALIGN_8K,
+                                                                  PCIE_CFG_SHADOW_TABLE_SZ);
+  if (!g_pcie_cfg_shadow)
+      val_print(ACS_PRINT_WARN,
+        "       PCIe config shadow allocation failed, reading hardware\n", 0);
+  else
+      g_pcie_cfg_shadow->num_entries = 0;
+#endif
+
   num_ecam = (uint32_t)val_pcie_get_info(PCIE_INFO_NUM_ECAM, 0);
   if (num_ecam == 0)
   {
@@ -576,7 +1087,10 @@ val_pcie_create_device_bdf_table()
 
           for (dev_index = 0; dev_index < PCIE_MAX_DEV; dev_index++)
           {
-              for (func_index = 0; func_index < PCIE_MAX_FUNC; func_index++)
+              /* Function 0 decides how many Functions the device has */
+              num_func = PCIE_MAX_FUNC;
+
+              for (func_index = 0; func_index < num_func; func_index++)
               {
                   /* Form bdf using seg, bus, device, function numbers */
                   bdf = PCIE_CREATE_BDF(seg_num, bus_index, dev_index, func_index);
@@ -589,9 +1103,20 @@ val_pcie_create_device_bdf_table()
                       return 1;
                   }
 
+                  /* A device without Function 0 is not present */
+                  if ((func_index == 0) && (reg_value == PCIE_UNKNOWN_RESPONSE))
+                      break;
+
                   /* Store the Function's BDF if there was a valid response */
                   if (reg_value != PCIE_UNKNOWN_RESPONSE)
                   {
+                      /* Snapshot header and capabilities for the queries below */
+                      val_pcie_cfg_shadow_capture(bdf);
+
+                      /* Functions 1-7 exist only for a multi-function device */
+                      if ((func_index == 0) && val_pcie_multifunction_support(bdf))
+                          num_func = 1;
+
                       /* Skip if the device is a host bridge */
                       if (val_pcie_is_host_bridge(bdf)) {
                           val_print(ACS_PRINT_DEBUG,
@@ -645,12 +1170,19 @@ val_pcie_create_device_bdf_table()
       }
   }
 
+  /* Index parent/rootport relations once, queries below are then O(1) */
+  val_pcie_create_topology_index();
+
   /* Sanity Check : Confirm all EP (normal, integrated) have a rootport */
   val_pcie_populate_device_rootport();
 
   val_print(ACS_PRINT_TEST,
     " PCIE_INFO: Number of BDFs found      :    %d\n", g_pcie_bdf_table->num_entries);
 
+  if (g_pcie_cfg_shadow)
+      val_print(ACS_PRINT_DEBUG,
+        " PCIE_INFO: Number of BDFs shadowed   :    %d\n", g_pcie_cfg_shadow->num_entries);
+
   return 0;
 }
 
@@ -730,6 +1262,18 @@ val_pcie_bdf_table_ptr()
 void
 val_pcie_free_info_table(void)
 {
+    if (g_pcie_ecam_lookup != NULL) {
+        pal_mem_free_aligned((void *)g_pcie_ecam_lookup);
+        g_pcie_ecam_lookup = NULL;
+    }
+
+    if (g_pcie_cfg_shadow != NULL) {
+        pal_mem_free_aligned((void *)g_pcie_cfg_shadow);
+        g_pcie_cfg_shadow = NULL;
+    }
+
+    val_pcie_topology_invalidate();
+
     if (g_pcie_info_table != NULL) {
         pal_mem_free_aligned((void *)g_pcie_info_table);
         g_pcie_info_table = NULL;
@@ -904,15 +1448,25 @@ val_pcie_device_port_type(uint32_t bdf)
   uint32_t reg_value;
   uint32_t dp_type;
   uint32_t status;
+  pcie_cfg_shadow_entry *entry;
 
-  /* Get the PCI Express Capability structure offset and
-   * use that offset to read pci express capabilities register
-   */
-  val_pcie_find_capability(bdf, PCIE_CAP, CID_PCIECS, &pciecs_base);
-  status = val_pcie_read_cfg(bdf, pciecs_base + CIDR_OFFSET, &reg_value);
+  entry = val_pcie_cfg_shadow_lookup(bdf);
+  if ((entry != NULL) && (entry->pciecs_base != 0))
+  {
+      /* PCI Express capabilities register captured in the shadow */
+      reg_value = entry->pciecs_value;
+  }
+  else
+  {
+      /* Get the PCI Express Capability structure offset and
+       * use that offset to read pci express capabilities register
+       */
+      val_pcie_find_capability(bdf, PCIE_CAP, CID_PCIECS, &pciecs_base);
+      status = val_pcie_read_cfg(bdf, pciecs_base + CIDR_OFFSET, &reg_value);
 
-  if (status)
-      return PCIE_UNKNOWN_RESPONSE;
+      if (status)
+          return PCIE_UNKNOWN_RESPONSE;
+  }
 
   /* Read Device/Port bits [7:4] in Function's PCIe Capabilities register */
   dp_type = (reg_value >> ((PCIECR_OFFSET - CIDR_OFFSET)*8 +
@@ -950,6 +1504,38 @@ val_pcie_find_capability(uint32_t bdf, uint32_t cid_type, uint32_t cid, uint32_t
   uint32_t reg_value;
   uint32_t next_cap_offset;
   uint32_t ret;
+  uint32_t index;
+  uint32_t num_cap;
+  pcie_cfg_shadow_cap *cap;
+  pcie_cfg_shadow_entry *entry;
+
+  /* Serve from the shadow when the whole list was captured */
+  entry = val_pcie_cfg_shadow_lookup(bdf);
+  if (entry != NULL)
+  {
+      cap = NULL;
+      num_cap = 0;
+      if ((cid_type == PCIE_CAP) && entry->cap_complete) {
+          cap = entry->cap;
+          num_cap = entry->num_cap;
+      } else if ((cid_type == PCIE_ECAP) && entry->ecap_complete) {
+          cap = entry->ecap;
+          num_cap = entry->num_ecap;
+      }
+
+      if (cap != NULL)
+      {
+          for (index = 0; index < num_cap; index++)
+          {
+              if (cap[index].id == cid)
+              {
+                  *cid_offset = cap[index].offset;
+                  return PCIE_SUCCESS;
+              }
+          }
+          return PCIE_CAP_NOT_FOUND;
+      }
+  }
 
   if (cid_type == PCIE_CAP) {
 
@@ -1369,8 +1955,238 @@ uint32_t val_pcie_bitfield_check(uint32_t bdf, uint64_t *bitfield_entry)
   return 0;
 }
 
+/**
+  @brief  Groups the entries of a bit-field table by register, so that each
+          register is located, read and probed once per Function.
+
+  @param  bf_info_table - table of registers and their bit-fields for checking
+  @param  num_entries   - Number of entries, at most MAX_BITFIELD_ENTRIES
+  @param  group         - On return, one group per register
+  @param  order         - On return, entry indices ordered group by group
+  @return Number of groups
+**/
+static uint32_t
+val_pcie_bitfield_group(pcie_cfgreg_bitfield_entry *bf_info_table, uint32_t num_entries,
+                        pcie_bitfield_reg_group *group, uint8_t *order)
+{
+  uint32_t index;
+  uint32_t grp;
+  uint32_t pos;
+  uint32_t num_groups;
+  uint16_t cap_id;
+  uint16_t reg_offset;
+  pcie_cfgreg_bitfield_entry *bf_entry;
+
+  num_groups = 0;
+  for (index = 0; index < num_entries; index++)
+  {
+      bf_entry = &bf_info_table[index];
+      cap_id = (bf_entry->reg_type == PCIE_ECAP) ? bf_entry->ecap_id :
+               (bf_entry->reg_type == PCIE_CAP) ? bf_entry->cap_id : 0;
+      reg_offset = bf_entry->reg_offset & ~WORD_ALIGN_MASK;
+
+      for (grp = 0; grp < num_groups; grp++)
+      {
+          if ((group[grp].reg_type == bf_entry->reg_type) && (group[grp].cap_id == cap_id) &&
+              (group[grp].reg_offset == reg_offset))
+              break;
+      }
+
+      if (grp == num_groups)
+      {
+          group[grp].reg_type = bf_entry->reg_type;
+          group[grp].cap_id = cap_id;
+          group[grp].reg_offset = reg_offset;
+          group[grp].dev_port_bitmask = 0;
+          group[grp].count = 0;
+          num_groups++;
+      }
+
+      group[grp].dev_port_bitmask |= bf_entry->dev_port_bitmask;
+      group[grp].count++;
+  }
+
+  /* Lay out entry indices group by group, keeping table order within a group */
+  pos = 0;
+  for (grp = 0; grp < num_groups; grp++)
+  {
+      group[grp].first = pos;
+      for (index = 0; index < num_entries; index++)
+      {
+          bf_entry = &bf_info_table[index];
+          cap_id = (bf_entry->reg_type == PCIE_ECAP) ? bf_entry->ecap_id :
+                   (bf_entry->reg_type == PCIE_CAP) ? bf_entry->cap_id : 0;
+          if ((group[grp].reg_type == bf_entry->reg_type) && (group[grp].cap_id == cap_id) &&
+              (group[grp].reg_offset == (bf_entry->reg_offset & ~WORD_ALIGN_MASK)))
+              order[pos++] = index;
+      }
+  }
+
+  return num_groups;
+}
+
+/**
+  @brief  Checks all bit-field entries of one register group for a Function.
+          The register is read once, and attributes of all bit-fields are
+          probed with a single write, readback and restore.
+
+  @param  bdf           - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+  @param  dp_type       - Device/port type of the Function
+  @param  cap_base      - Base of the capability holding the register
+  @param  bf_info_table - table of registers and their bit-fields for checking
+  @param  group         - Register group to check
+  @param  order         - Entry indices ordered group by group
+  @param  num_pass      - Incremented for each passing bit-field entry
+  @param  num_fails     - Incremented for each failing bit-field entry
+  @return None
+**/
+static void
+val_pcie_bitfield_check_group(uint32_t bdf, uint32_t dp_type, uint32_t cap_base,
+                              pcie_cfgreg_bitfield_entry *bf_info_table,
+                              pcie_bitfield_reg_group *group, uint8_t *order,
+                              uint32_t *num_pass, uint32_t *num_fails)
+{
+  uint32_t index;
+  uint32_t shift;
+  uint32_t mask;
+  uint32_t reg_addr;
+  uint32_t reg_value;
+  uint32_t read_value;
+  uint32_t expected;
+  uint32_t probe_value;
+  uint32_t toggle_mask;
+  uint32_t clear_mask;
+  uint32_t used_mask;
+  uint32_t probe_list;
+  pcie_cfgreg_bitfield_entry *bf_entry;
+
+  reg_addr = cap_base + group->reg_offset;
+
+  /* To prevent status bits are clear when write 1, just clear it firstly */
+  val_pcie_read_cfg(bdf, reg_addr, &reg_value);
+  val_pcie_write_cfg(bdf, reg_addr, reg_value);
+  val_pcie_read_cfg(bdf, reg_addr, &reg_value);
+
+  /* Check values, collect the attribute probes of matching bit-fields */
+  toggle_mask = 0;
+  clear_mask = 0;
+  used_mask = 0;
+  probe_list = 0;
+  for (index = 0; index < group->count; index++)
+  {
+      bf_entry = &bf_info_table[order[group->first + index]];
+      if (!(dp_type & bf_entry->dev_port_bitmask))
+          continue;
+
+      shift = REG_SHIFT(bf_entry->reg_offset & WORD_ALIGN_MASK, bf_entry->start);
+      mask = REG_MASK(bf_entry->end, bf_entry->start) << shift;
+
+      if (((reg_value & mask) >> shift) != bf_entry->cfg_value)
+      {
+          val_print(ACS_PRINT_ERR, "\n       BDF 0x%x : ", bdf);
+          val_print(ACS_PRINT_ERR, bf_entry->err_str1, 0);
+          val_print(ACS_PRINT_ERR, ": 0x%x", (reg_value & mask) >> shift);
+          val_print(ACS_PRINT_ERR, " instead of 0x%x", bf_entry->cfg_value);
+          if (!val_strncmp(bf_entry->err_str1, "WARNING", WARN_STR_LEN))
+              (*num_pass)++;
+          else
+              (*num_fails)++;
+          continue;
+      }
+
+      /* Overlapping bit-fields cannot share a probe, check them one at a time */
+      if (used_mask & mask)
+      {
+          if (val_pcie_bitfield_check(bdf, (void *)bf_entry))
+              (*num_fails)++;
+          else
+              (*num_pass)++;
+          continue;
+      }
+
+      switch (bf_entry->attr)
+      {
+          case HW_INIT:
+          case READ_ONLY:
+          case STICKY_RO:
+          case READ_WRITE:
+          case STICKY_RW:
+              toggle_mask |= mask;
+              break;
+          case RSVDZ_RO:
+              clear_mask |= mask;
+              break;
+          case RSVDP_RO:
+              break;
+          default:
+              val_print(ACS_PRINT_ERR, "\n       Invalid Attribute : 0x%x  ", bf_entry->attr);
+              (*num_fails)++;
+              continue;
+      }
+
+      used_mask |= mask;
+      probe_list |= (1u << index);
+  }
+
+  if (probe_list == 0)
+      return;
+
+  /* One write covers every bit-field: toggle RO/RW, zero RsvdZ, preserve RsvdP */
+  probe_value = (reg_value ^ toggle_mask) & ~clear_mask;
+  val_pcie_write_cfg(bdf, reg_addr, probe_value);
+  val_pcie_read_cfg(bdf, reg_addr, &read_value);
+
+  /* Restore the original register value */
+  val_pcie_write_cfg(bdf, reg_addr, reg_value);
+
+  for (index = 0; index < group->count; index++)
+  {
+      if (!(probe_list & (1u << index)))
+          continue;
+
+      bf_entry = &bf_info_table[order[group->first + index]];
+      shift = REG_SHIFT(bf_entry->reg_offset & WORD_ALIGN_MASK, bf_entry->start);
+      mask = REG_MASK(bf_entry->end, bf_entry->start) << shift;
+
+      switch (bf_entry->attr)
+      {
+          case READ_WRITE:
+          case STICKY_RW:
+              /* Software can alter these bits */
+              expected = probe_value & mask;
+              break;
+          case RSVDP_RO:
+              /* Software must return 0 when read */
+              expected = 0;
+              break;
+          default:
+              /* Software must not alter these bits */
+              expected = reg_value & mask;
+              break;
+      }
+
+      if ((read_value & mask) != expected)
+      {
+          val_print(ACS_PRINT_ERR, "\n       BDF 0x%x : ", bdf);
+          val_print(ACS_PRINT_ERR, bf_entry->err_str2, 0);
+          val_print(ACS_PRINT_ERR, ": 0x%x", (read_value & mask) >> shift);
+          val_print(ACS_PRINT_ERR, " instead of 0x%x", expected >> shift);
+          if (!val_strncmp(bf_entry->err_str2, "WARNING", WARN_STR_LEN))
+              (*num_pass)++;
+          else
+              (*num_fails)++;
+          continue;
+      }
+
+      val_print(ACS_PRINT_INFO, "\n       BDF 0x%x : PASS", bdf);
+      (*num_pass)++;
+  }
+}
+
 /**
   @brief  Returns if a PCIe config register bitfields are as per bsa specification.
+          Entries are grouped by register, each capability is located once per
+          Function and each register is read and probed once for all its entries.
 
   @param  bf_info_table - table of registers and their bit-fields for checking
   @param  num_bitfield_entries - Number of entries
@@ -1388,13 +2204,34 @@ val_pcie_register_bitfields_check(uint64_t *bf_info_table, uint32_t num_bitfield
   uint32_t num_fails;
   uint32_t num_pass;
   uint32_t index;
+  uint32_t grp;
+  uint32_t num_groups;
+  uint32_t cap_base;
+  uint32_t status;
+  pcie_cfgreg_bitfield_entry *bf_table;
   pcie_cfgreg_bitfield_entry *bf_entry;
+  pcie_bitfield_reg_group group[MAX_BITFIELD_ENTRIES];
+  uint8_t order[MAX_BITFIELD_ENTRIES];
 
   num_fails = num_pass = tbl_index = 0;
+  dp_type = 0;
+  bf_table = (pcie_cfgreg_bitfield_entry *)bf_info_table;
 
   val_print(ACS_PRINT_INFO, "\n       Number of bit-field entries to check %d",
             num_bitfield_entries);
 
+  /* Group size is tracked in a 32-bit probe list */
+  num_groups = 0;
+  if (num_bitfield_entries <= MAX_BITFIELD_ENTRIES)
+  {
+      num_groups = val_pcie_bitfield_group(bf_table, num_bitfield_entries, group, order);
+      for (grp = 0; grp < num_groups; grp++)
+      {
+          if (group[grp].count > 32)
+              num_groups = 0;
+      }
+  }
+
   while (tbl_index < g_pcie_bdf_table->num_entries)
   {
       bdf = g_pcie_bdf_table->device[tbl_index++].bdf;
@@ -1405,29 +2242,57 @@ val_pcie_register_bitfields_check(uint64_t *bf_info_table, uint32_t num_bitfield
       /* Get the Function's device/port type from bdf */
       dp_type = val_pcie_device_port_type(bdf);
 
-      /* Set variables to iterate over all bit-field entries */
-      bf_entry = (pcie_cfgreg_bitfield_entry *)&(bf_info_table[0]);
+      if (num_groups == 0)
+      {
+          /* Table could not be grouped, check entries one at a time */
+          for (index = 0; index < num_bitfield_entries; index++)
+          {
+              bf_entry = &bf_table[index];
+              if (!(dp_type & bf_entry->dev_port_bitmask))
+                  continue;
+
+              if (val_pcie_bitfield_check(bdf, (void *)bf_entry))
+                  num_fails++;
+              else
+                  num_pass++;
+          }
+          continue;
+      }
 
-      for (index = 0; index < num_bitfield_entries; index++)
+      for (grp = 0; grp < num_groups; grp++)
       {
-          /*
-           * Skip this entry checking, if the Function
-           * is not part of it's device/port bit mask.
-           */
-          if (!(dp_type & bf_entry->dev_port_bitmask))
+          /* Skip groups without an entry for this device/port type */
+          if (!(dp_type & group[grp].dev_port_bitmask))
+              continue;
+
+          cap_base = 0;
+          status = PCIE_SUCCESS;
+          if (group[grp].reg_type == PCIE_CAP)
+              status = val_pcie_find_capability(bdf, PCIE_CAP, group[grp].cap_id, &cap_base);
+          else if (group[grp].reg_type == PCIE_ECAP)
+              status = val_pcie_find_capability(bdf, PCIE_ECAP, group[grp].cap_id, &cap_base);
+          else if (group[grp].reg_type != HEADER)
+              status = 1;
+
+          if (status != PCIE_SUCCESS)
           {
-              bf_entry++;
+              /* Let the per-entry check report the missing capability */
+              for (index = 0; index < group[grp].count; index++)
+              {
+                  bf_entry = &bf_table[order[group[grp].first + index]];
+                  if (!(dp_type & bf_entry->dev_port_bitmask))
+                      continue;
+
+                  if (val_pcie_bitfield_check(bdf, (void *)bf_entry))
+                      num_fails++;
+                  else
+                      num_pass++;
+              }
               continue;
           }
 
-          /* Check for the compliance */
-          if (val_pcie_bitfield_check(bdf, (void *)bf_entry))
-              num_fails++;
-          else
-              num_pass++;
-
-          /* Adjust the pointer to next bf */
-          bf_entry++;
+          val_pcie_bitfield_check_group(bdf, dp_type, cap_base, bf_table, &group[grp], order,
+                                        &num_pass, &num_fails);
       }
   }
 
@@ -1454,7 +2319,7 @@ val_pcie_function_header_type(uint32_t bdf)
   uint32_t reg_value;
 
   /* Read four bytes of config space starting from cache line size register */
-  val_pcie_read_cfg(bdf, TYPE01_CLSR, &reg_value);
+  val_pcie_cfg_shadow_read(bdf, TYPE01_CLSR, &reg_value);
 
   /* Extract header type register value */
   reg_value = ((reg_value >> TYPE01_HTR_SHIFT) & TYPE01_HTR_MASK);
@@ -1578,11 +2443,22 @@ val_pcie_get_downstream_function(uint32_t bdf, uint32_t *dsf_bdf)
    * register and extract the Secondary and Subordinate Bus numbers
    * and the segment.
    */
-  val_pcie_read_cfg(bdf, TYPE1_PBN, &reg_value);
+  val_pcie_cfg_shadow_read(bdf, TYPE1_PBN, &reg_value);
   sec_bus = ((reg_value >> SECBN_SHIFT) & SECBN_MASK);
   sub_bus = ((reg_value >> SUBBN_SHIFT) & SUBBN_MASK);
   seg = (PCIE_EXTRACT_BDF_SEG(bdf));
 
+  /* Resolve from the topology index when present */
+  if (g_pcie_topology != NULL)
+  {
+      index = val_pcie_topology_dsf(seg, sec_bus, sub_bus);
+      if (index == PCIE_TOPOLOGY_NO_INDEX)
+          return 1;
+
+      *dsf_bdf = g_pcie_bdf_table->device[index].bdf;
+      return 0;
+  }
+
   /*
    * Search for a pcie Function whose bus number is within the range of
    * target bridge's bus numbers downstream, from the value of Secondary
@@ -1640,6 +2516,7 @@ val_pcie_get_rootport(uint32_t bdf, uint32_t *rp_bdf)
   uint32_t seg_num;
   uint32_t reg_value;
   uint32_t dp_type;
+  pcie_topology_bus *slot;
 
   index = 0;
 
@@ -1661,6 +2538,19 @@ val_pcie_get_rootport(uint32_t bdf, uint32_t *rp_bdf)
       return 1;
   }
 
+  /* Resolve from the topology index when present */
+  if (g_pcie_topology != NULL)
+  {
+      slot = val_pcie_topology_bus(PCIE_EXTRACT_BDF_SEG(bdf), PCIE_EXTRACT_BDF_BUS(bdf));
+      if ((slot != NULL) && (slot->rootport != PCIE_TOPOLOGY_NO_INDEX))
+      {
+          *rp_bdf = g_pcie_bdf_table->device[slot->rootport].bdf;
+          return 0;
+      }
+
+      index = g_pcie_bdf_table->num_entries;
+  }
+
   while (index < g_pcie_bdf_table->num_entries)
   {
       *rp_bdf = g_pcie_bdf_table->device[index++].bdf;
@@ -1701,7 +2591,7 @@ val_pcie_is_host_bridge(uint32_t bdf)
 {
   uint32_t  reg_value;
 
-  val_pcie_read_cfg(bdf, TYPE01_RIDR, &reg_value);
+  val_pcie_cfg_shadow_read(bdf, TYPE01_RIDR, &reg_value);
   if ((HB_BASE_CLASS == ((reg_value >> CC_BASE_SHIFT) & CC_BASE_MASK)) &&
       (HB_SUB_CLASS == ((reg_value >> CC_SUB_SHIFT) & CC_SUB_MASK)))
     return 1;
@@ -1890,7 +2780,7 @@ uint32_t
 val_pcie_multifunction_support(uint32_t bdf)
 {
   uint32_t reg_data;
-  val_pcie_read_cfg(bdf, TYPE01_CLSR, &reg_data);
+  val_pcie_cfg_shadow_read(bdf, TYPE01_CLSR, &reg_data);
   reg_data = ((reg_data >> TYPE01_HTR_SHIFT) & TYPE01_HTR_MASK);
 
   return !((reg_data >> HTR_MFD_SHIFT) & HTR_MFD_MASK);
@@ -2246,11 +3136,23 @@ val_pcie_parent_is_rootport(uint32_t dsf_bdf, uint32_t *rp_bdf)
   uint32_t tbl_index;
   uint32_t reg_value;
   pcie_device_bdf_table *bdf_tbl_ptr;
+  pcie_topology_bus *slot;
 
   tbl_index = 0;
   dsf_bus = PCIE_EXTRACT_BDF_BUS(dsf_bdf);
   bdf_tbl_ptr = val_pcie_bdf_table_ptr();
 
+  /* Parent Root Port is indexed by its secondary bus */
+  if (g_pcie_topology != NULL)
+  {
+      slot = val_pcie_topology_bus(PCIE_EXTRACT_BDF_SEG(dsf_bdf), dsf_bus);
+      if ((slot == NULL) || (slot->parent_rp == PCIE_TOPOLOGY_NO_INDEX))
+          return 1;
+
+      *rp_bdf = bdf_tbl_ptr->device[slot->parent_rp].bdf;
+      return 0;
+  }
+
   while (tbl_index < bdf_tbl_ptr->num_entries)
   {
       bdf = bdf_tbl_ptr->device[tbl_index++].bdf;
@@ -18,10 +18,14 @@
 #include "include/acs_val.h"
 #include "include/acs_pe.h"
 #include "include/acs_common.h"
+#include "include/acs_memory.h"
 #include "include/acs_std_smc.h"
 #include "driver/gic/acs_exception.h"
 #include "include/val_interface.h"
 #include "include/pal_interface.h"
+#ifndef TARGET_LINUX
+#include "include/acs_timer_support.h"
+#endif
 
 PE_SMBIOS_PROCESSOR_INFO_TABLE *g_smbios_info_table;
 int32_t gPsciConduit;
@@ -41,6 +45,15 @@ ARM_SMC_ARGS g_smc_args;
 /* global variable to store primary PE index */
 uint32_t g_primary_pe_index = 0;
 
+#ifndef TARGET_LINUX
+/* MPIDR to PE index hash, built once by val_pe_create_info_table */
+static PE_MPID_HASH_ENTRY *g_pe_mpid_hash;
+static uint32_t g_pe_mpid_hash_bits;
+
+static void val_pe_mpid_hash_init(void);
+static void val_pe_index_benchmark(void);
+#endif
+
 /**
   @brief   This API will call PAL layer to fill in the PE information
            into the g_pe_info_table pointer.
@@ -93,6 +106,12 @@ val_print(ACS_PRINT_TEST, " Primary PE: MIDR_EL1                 :    0x%llx \n"
                                                                      val_pe_reg_read(MIDR_EL1));
 #endif
 
+#ifndef TARGET_LINUX
+  val_pe_mpid_hash_init();
+  if (g_print_level <= ACS_PRINT_DEBUG)
+      val_pe_index_benchmark();
+#endif
+
   /* store primary PE index for debug message printing purposes on
      multi PE tests */
   g_primary_pe_index = val_pe_get_index_mpid(val_pe_get_mpid());
@@ -112,6 +131,16 @@ val_print(ACS_PRINT_TEST, " Primary PE: MIDR_EL1                 :    0x%llx \n"
 void
 val_pe_free_info_table(void)
 {
+#ifndef TARGET_LINUX
+    val_pe_pool_release();
+
+    if (g_pe_mpid_hash != NULL) {
+        pal_mem_free_aligned((void *)g_pe_mpid_hash);
+        g_pe_mpid_hash = NULL;
+        val_data_cache_ops_by_va((addr_t)&g_pe_mpid_hash, CLEAN_AND_INVALIDATE);
+    }
+#endif
+
     if (g_pe_info_table != NULL) {
         pal_mem_free_aligned((void *)g_pe_info_table);
         g_pe_info_table = NULL;
@@ -189,20 +218,19 @@ val_pe_get_mpid_index(uint32_t index)
 
 
 /**
-  @brief   This API returns the index of the PE whose MPIDR matches with the input MPIDR
-           1. Caller       -  Test Suite, VAL
-           2. Prerequisite -  val_create_peinfo_table
-  @param   mpid - the mpidr value of pE whose index is returned.
-  @return  Index of PE
+  @brief   Linear search of a PE info table for an MPIDR.
+  @param   table - PE info table to search
+  @param   mpid  - the mpidr value of PE whose index is returned.
+  @return  Index of PE, 0 if not found
 **/
-uint32_t
-val_pe_get_index_mpid(uint64_t mpid)
+static uint32_t
+val_pe_index_scan(PE_INFO_TABLE *table, uint64_t mpid)
 {
 
   PE_INFO_ENTRY *entry;
-  uint32_t i = g_pe_info_table->header.num_of_pe;
+  uint32_t i = table->header.num_of_pe;
 
-  entry = g_pe_info_table->pe_info;
+  entry = table->pe_info;
 
   while (i > 0) {
     val_data_cache_ops_by_va((addr_t)&entry->mpidr, INVALIDATE);
@@ -218,6 +246,505 @@ val_pe_get_index_mpid(uint64_t mpid)
   return 0x0;  //Return index 0 as a safe failsafe value
 }
 
+#ifndef TARGET_LINUX
+/**
+  @brief   Hash slot of an MPIDR, from its Aff3..Aff0 fields
+  @param   mpid - MPIDR value
+  @param   bits - log2 of the number of slots
+  @return  Slot index
+**/
+static uint32_t
+val_pe_mpid_hash_slot(uint64_t mpid, uint32_t bits)
+{
+  uint32_t aff;
+
+  mpid &= MPIDR_AFF_MASK;
+  aff = (uint32_t)(mpid & 0xFFFFFF) | (uint32_t)((mpid >> 8) & 0xFF000000);
+
+  return (aff * PE_MPID_HASH_MULT) >> (32 - bits);
+}
+
+/**
+  @brief   Build an MPIDR to PE index hash for a PE info table. The table is
+           cleaned to the point of coherency once, so lookups from any PE need
+           no further cache maintenance.
+  @param   table - PE info table
+  @param   bits  - returns log2 of the number of slots
+  @return  Hash slots, NULL if allocation failed
+**/
+static PE_MPID_HASH_ENTRY *
+val_pe_mpid_hash_build(PE_INFO_TABLE *table, uint32_t *bits)
+{
+  PE_MPID_HASH_ENTRY *hash;
+  PE_INFO_ENTRY *entry = table->pe_info;
+  uint32_t num_pe = table->header.num_of_pe;
+  uint32_t b = PE_MPID_HASH_MIN_BITS;
+  uint32_t size, slot, i;
+
+  /* Keep the load factor at or below one half */
+  while ((1u << b) < (2 * num_pe))
+      b++;
+
+  size = (1u << b) * sizeof(PE_MPID_HASH_ENTRY);
+  hash = (PE_MPID_HASH_ENTRY *)pal_aligned_alloc(MEM_ALIGN_4K, size);
+  if (hash == NULL)
+      return NULL;
+
+  val_memory_set(hash, size, 0);
+
+  for (i = 0; i < num_pe; i++, entry++) {
+      slot = val_pe_mpid_hash_slot(entry->mpidr, b);
+      while (hash[slot].valid && (hash[slot].mpidr != entry->mpidr))
+          slot = (slot + 1) & ((1u << b) - 1);
+
+      /* First entry wins on duplicate MPIDRs, as with the linear search */
+      if (hash[slot].valid)
+          continue;
+
+      hash[slot].mpidr = entry->mpidr;
+      hash[slot].pe_index = entry->pe_num;
+      hash[slot].valid = 1;
+  }
+
+  val_pe_cache_clean_range((uint64_t)hash, size);
+  *bits = b;
+  return hash;
+}
+
+/**
+  @brief   Look up an MPIDR in a hash built by val_pe_mpid_hash_build
+  @param   hash - Hash slots
+  @param   bits - log2 of the number of slots
+  @param   mpid - the mpidr value of PE whose index is returned.
+  @return  Index of PE, 0 if not found
+**/
+static uint32_t
+val_pe_mpid_hash_lookup(PE_MPID_HASH_ENTRY *hash, uint32_t bits, uint64_t mpid)
+{
+  uint32_t slot = val_pe_mpid_hash_slot(mpid, bits);
+
+  while (hash[slot].valid) {
+      if (hash[slot].mpidr == mpid)
+          return hash[slot].pe_index;
+      slot = (slot + 1) & ((1u << bits) - 1);
+  }
+
+  return 0x0;
+}
+
+/**
+  @brief   Build the MPIDR to PE index hash for g_pe_info_table. Lookups fall
+           back to the linear search if the hash cannot be allocated.
+  @param   None
+  @return  None
+**/
+static void
+val_pe_mpid_hash_init(void)
+{
+  g_pe_mpid_hash = val_pe_mpid_hash_build(g_pe_info_table, &g_pe_mpid_hash_bits);
+  if (g_pe_mpid_hash == NULL)
+      val_print(ACS_PRINT_WARN, "\n PE_INFO: MPIDR hash not allocated, using linear search", 0);
+
+  val_data_cache_ops_by_va((addr_t)&g_pe_mpid_hash, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&g_pe_mpid_hash_bits, CLEAN_AND_INVALIDATE);
+}
+
+/**
+  @brief   Compare the cost of the linear MPIDR search and the hash lookup on
+           synthetic PE tables of 8, 64 and 256 PEs, and print ns per lookup.
+  @param   None
+  @return  None
+**/
+static void
+val_pe_index_benchmark(void)
+{
+  uint32_t num_pe[] = {8, 64, 256};
+  PE_INFO_TABLE *table;
+  PE_MPID_HASH_ENTRY *hash;
+  uint64_t start, scan_ticks, hash_ticks, freq;
+  uint32_t bits, n, i, j;
+  volatile uint32_t sink = 0;
+
+  /* Runs before the timer info table is created, read CNTFRQ_EL0 directly */
+  freq = ArmReadCntFrq();
+  if (freq == 0)
+      return;
+
+  for (n = 0; n < sizeof(num_pe) / sizeof(num_pe[0]); n++) {
+      table = (PE_INFO_TABLE *)pal_aligned_alloc(MEM_ALIGN_4K,
+                  sizeof(PE_INFO_HDR) + num_pe[n] * sizeof(PE_INFO_ENTRY));
+      if (table == NULL)
+          return;
+
+      /* One PE per Aff1 value, four Aff1 clusters per Aff2 */
+      table->header.num_of_pe = num_pe[n];
+      for (i = 0; i < num_pe[n]; i++) {
+          table->pe_info[i].pe_num = i;
+          table->pe_info[i].mpidr = ((uint64_t)(i / 4) << 16) | ((uint64_t)(i % 4) << 8);
+      }
+
+      hash = val_pe_mpid_hash_build(table, &bits);
+      if (hash == NULL) {
+          pal_mem_free_aligned((void *)table);
+          return;
+      }
+
+      start = ArmReadCntPct();
+      for (j = 0; j < PE_INDEX_BENCH_LOOKUPS; j++)
+          sink += val_pe_index_scan(table, table->pe_info[j % num_pe[n]].mpidr);
+      scan_ticks = ArmReadCntPct() - start;
+
+      start = ArmReadCntPct();
+      for (j = 0; j < PE_INDEX_BENCH_LOOKUPS; j++)
+          sink += val_pe_mpid_hash_lookup(hash, bits, table->pe_info[j % num_pe[n]].mpidr);
+      hash_ticks = ArmReadCntPct() - start;
+
+      val_print(ACS_PRINT_DEBUG, "\n PE index lookup, %d PEs", num_pe[n]);
+      val_print(ACS_PRINT_DEBUG, ": scan %ld ns",
+                (scan_ticks * 1000000000 / freq) / PE_INDEX_BENCH_LOOKUPS);
+      val_print(ACS_PRINT_DEBUG, ", hash %ld ns",
+                (hash_ticks * 1000000000 / freq) / PE_INDEX_BENCH_LOOKUPS);
+
+      pal_mem_free_aligned((void *)hash);
+      pal_mem_free_aligned((void *)table);
+  }
+  val_print(ACS_PRINT_DEBUG, "\n", 0);
+  (void)sink;
+}
+#endif
+
+/**
+  @brief   This API returns the index of the PE whose MPIDR matches with the input MPIDR
+           1. Caller       -  Test Suite, VAL
+           2. Prerequisite -  val_create_peinfo_table
+  @param   mpid - the mpidr value of pE whose index is returned.
+  @return  Index of PE
+**/
+uint32_t
+val_pe_get_index_mpid(uint64_t mpid)
+{
+#ifndef TARGET_LINUX
+  if (g_pe_mpid_hash != NULL)
+      return val_pe_mpid_hash_lookup(g_pe_mpid_hash, g_pe_mpid_hash_bits, mpid);
+#endif
+
+  return val_pe_index_scan(g_pe_info_table, mpid);
+}
+
+
+#ifndef TARGET_LINUX
+/**
+  @brief   Return the cache writeback granule of the PE from CTR_EL0.CWG.
+           Memory written by more than one PE is laid out at this granule so
+           that no two PEs share a line.
+  @param   None
+  @return  Granule in bytes, VAL_SHARED_MEM_CWG_MAX if CWG is not reported
+**/
+uint32_t
+val_pe_cache_wb_granule(void)
+{
+  uint32_t cwg;
+
+  /* CTR_EL0.CWG is log2 of the writeback granule in words */
+  cwg = (val_pe_reg_read(CTR_EL0) >> 24) & 0xF;
+  return cwg ? (4 << cwg) : VAL_SHARED_MEM_CWG_MAX;
+}
+
+/**
+  @brief   Mailboxes of the secondary PE worker pool, indexed by PE index.
+           Each mailbox is a command line followed by an ack line of
+           g_pe_pool_line bytes. NULL while the pool is disabled.
+**/
+static uint8_t *g_pe_pool;
+static uint32_t g_pe_pool_size;
+static uint32_t g_pe_pool_line;
+
+/**
+  @brief   Return the command half of a PE's pool mailbox
+  @param   index - PE index
+  @return  Pointer to the command line
+**/
+static VAL_PE_POOL_CMD *
+val_pe_pool_cmd(uint32_t index)
+{
+  return (VAL_PE_POOL_CMD *)(g_pe_pool + (uint64_t)index * 2 * g_pe_pool_line);
+}
+
+/**
+  @brief   Return the ack half of a PE's pool mailbox
+  @param   index - PE index
+  @return  Pointer to the ack line
+**/
+static VAL_PE_POOL_ACK *
+val_pe_pool_ack(uint32_t index)
+{
+  return (VAL_PE_POOL_ACK *)(g_pe_pool + ((uint64_t)index * 2 + 1) * g_pe_pool_line);
+}
+
+/**
+  @brief   Enable the secondary PE worker pool. Once enabled, a secondary PE that
+           returns from its payload parks in WFE instead of calling PSCI CPU_OFF,
+           and later payloads are posted to its mailbox and woken with SEV.
+           1. Caller       -  Application layer
+           2. Prerequisite -  val_pe_create_info_table, val_allocate_shared_mem
+  @param   None
+  @return  ACS_STATUS_PASS on success, ACS_STATUS_ERR otherwise
+**/
+uint32_t
+val_pe_pool_enable(void)
+{
+  uint32_t num_pe;
+  uint32_t granule;
+  uint32_t line;
+  uint32_t size;
+
+  if (g_pe_pool != NULL)
+      return ACS_STATUS_PASS;
+
+  /* Round each mailbox half up to the writeback granule */
+  granule = val_pe_cache_wb_granule();
+  line = sizeof(VAL_PE_POOL_CMD);
+  if (line < sizeof(VAL_PE_POOL_ACK))
+      line = sizeof(VAL_PE_POOL_ACK);
+  line = ((line + granule - 1) / granule) * granule;
+
+  num_pe = val_pe_get_num();
+  size = num_pe * 2 * line;
+
+  g_pe_pool = (uint8_t *)pal_aligned_alloc(MEM_ALIGN_4K, size);
+  if (g_pe_pool == NULL) {
+      val_print(ACS_PRINT_ERR, "\n       PE pool: mailbox allocation failed", 0);
+      return ACS_STATUS_ERR;
+  }
+
+  val_memory_set(g_pe_pool, size, 0);
+  val_pe_cache_clean_range((uint64_t)g_pe_pool, size);
+
+  g_pe_pool_size = num_pe;
+  g_pe_pool_line = line;
+  val_data_cache_ops_by_va((addr_t)&g_pe_pool, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&g_pe_pool_size, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&g_pe_pool_line, CLEAN_AND_INVALIDATE);
+
+  val_print(ACS_PRINT_INFO, "\n       PE pool enabled for %d PEs", num_pe);
+  val_print(ACS_PRINT_DEBUG, ", mailbox line %d", line);
+  return ACS_STATUS_PASS;
+}
+
+/**
+  @brief   Park the calling secondary PE in the worker pool and run the payloads
+           posted to its mailbox until the pool is released.
+           1. Caller       -  val_test_entry
+           2. Prerequisite -  val_pe_pool_enable
+  @param   index - PE index of the calling PE
+  @return  None, returns when the PE should switch itself off
+**/
+static void
+val_pe_pool_worker(uint32_t index)
+{
+  VAL_PE_POOL_CMD *cmd;
+  VAL_PE_POOL_ACK *ack;
+  uint64_t seq;
+  uint64_t test_arg;
+  void (*vector)(uint64_t args);
+
+  val_data_cache_ops_by_va((addr_t)&g_pe_pool, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&g_pe_pool_size, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&g_pe_pool_line, CLEAN_AND_INVALIDATE);
+  if ((g_pe_pool == NULL) || (index >= g_pe_pool_size))
+      return;
+
+  cmd = val_pe_pool_cmd(index);
+  ack = val_pe_pool_ack(index);
+  val_data_cache_ops_by_va((addr_t)cmd, CLEAN_AND_INVALIDATE);
+  if (cmd->exit)
+      return;
+
+  seq = cmd->seq;
+  ack->done_seq = seq;
+  ack->parked = 1;
+  val_data_cache_ops_by_va((addr_t)ack, CLEAN_AND_INVALIDATE);
+
+  while (1) {
+      val_data_cache_ops_by_va((addr_t)cmd, CLEAN_AND_INVALIDATE);
+      if (cmd->seq == seq) {
+          /* A SEV issued after the check above is latched in the event register */
+          ArmCallWFE();
+          continue;
+      }
+
+      seq = cmd->seq;
+      if (cmd->exit)
+          break;
+
+      val_get_test_data(index, (uint64_t *)&vector, &test_arg);
+      vector(test_arg);
+
+      ack->done_seq = seq;
+      val_data_cache_ops_by_va((addr_t)ack, CLEAN_AND_INVALIDATE);
+  }
+
+  ack->done_seq = seq;
+  ack->parked = 0;
+  val_data_cache_ops_by_va((addr_t)ack, CLEAN_AND_INVALIDATE);
+}
+
+/**
+  @brief   Post a payload to a PE parked in the worker pool.
+           A PE that is not parked, or is still busy with a previous payload,
+           is left to the PSCI CPU_ON path.
+  @param   index - Index of the PE to run the payload
+  @param   payload - Function pointer of the test to be executed on the PE
+  @param   test_input - arguments to be passed to the test.
+  @return  1 if the payload was posted, 0 otherwise
+**/
+static uint32_t
+val_pe_pool_dispatch(uint32_t index, void (*payload)(void), uint64_t test_input)
+{
+  VAL_PE_POOL_CMD *cmd;
+  VAL_PE_POOL_ACK *ack;
+
+  if ((g_pe_pool == NULL) || (index >= g_pe_pool_size))
+      return 0;
+
+  cmd = val_pe_pool_cmd(index);
+  ack = val_pe_pool_ack(index);
+  val_data_cache_ops_by_va((addr_t)ack, CLEAN_AND_INVALIDATE);
+  if (!ack->parked || (ack->done_seq != cmd->seq))
+      return 0;
+
+  val_set_test_data(index, (uint64_t)payload, test_input);
+
+  cmd->seq++;
+  cmd->posted = 1;
+  val_data_cache_ops_by_va((addr_t)cmd, CLEAN_AND_INVALIDATE);
+  ArmCallSEV();
+
+  return 1;
+}
+
+/**
+  @brief   Completion check for val_wait_until, every posted payload acknowledged
+  @param   arg - Number of PE indices to check
+  @return  1 if all posted payloads are done
+**/
+static uint32_t
+val_pe_pool_all_done(void *arg)
+{
+  VAL_PE_POOL_CMD *cmd;
+  VAL_PE_POOL_ACK *ack;
+  uint32_t num_pe = (uint32_t)(uint64_t)arg;
+  uint32_t i;
+
+  for (i = 0; i < num_pe; i++) {
+      cmd = val_pe_pool_cmd(i);
+      if (!cmd->posted)
+          continue;
+
+      ack = val_pe_pool_ack(i);
+      val_data_cache_ops_by_va((addr_t)ack, CLEAN_AND_INVALIDATE);
+      if (ack->done_seq != cmd->seq)
+          return 0;
+  }
+
+  return 1;
+}
+
+/**
+  @brief   Barrier for payloads posted through the worker pool. Waits until every
+           PE with a posted payload has acknowledged its completion.
+           1. Caller       -  val_wait_for_test_completion
+           2. Prerequisite -  val_pe_pool_enable
+  @param   num_pe     - Number of PE indices to wait on
+  @param   timeout_us - Time budget shared by all the PEs
+  @return  Number of PEs that arrived at the barrier
+**/
+uint32_t
+val_pe_pool_wait(uint32_t num_pe, uint64_t timeout_us)
+{
+  VAL_PE_POOL_CMD *cmd;
+  uint32_t arrived = 0;
+  uint32_t i;
+
+  if (g_pe_pool == NULL)
+      return 0;
+
+  if (num_pe > g_pe_pool_size)
+      num_pe = g_pe_pool_size;
+
+  /* On timeout, the PEs not done are left to the caller's status scan */
+  val_wait_until(val_pe_pool_all_done, (void *)(uint64_t)num_pe, timeout_us);
+
+  for (i = 0; i < num_pe; i++) {
+      cmd = val_pe_pool_cmd(i);
+      if (!cmd->posted || (val_pe_pool_ack(i)->done_seq != cmd->seq))
+          continue;
+
+      cmd->posted = 0;
+      val_data_cache_ops_by_va((addr_t)cmd, CLEAN_AND_INVALIDATE);
+      arrived++;
+  }
+
+  return arrived;
+}
+
+/**
+  @brief   Completion check for val_wait_until, a pool PE has left its mailbox
+  @param   arg - Ack line of the PE's mailbox
+  @return  1 if the PE is no longer parked
+**/
+static uint32_t
+val_pe_pool_exited(void *arg)
+{
+  VAL_PE_POOL_ACK *ack = (VAL_PE_POOL_ACK *)arg;
+
+  val_data_cache_ops_by_va((addr_t)ack, CLEAN_AND_INVALIDATE);
+  return !ack->parked;
+}
+
+/**
+  @brief   Release the PEs parked in the worker pool so they switch themselves
+           off, and disable the pool.
+           1. Caller       -  val_pe_free_info_table
+  @param   None
+  @return  None
+**/
+void
+val_pe_pool_release(void)
+{
+  VAL_PE_POOL_CMD *cmd;
+  uint32_t stuck = 0;
+  uint32_t i;
+
+  if (g_pe_pool == NULL)
+      return;
+
+  for (i = 0; i < g_pe_pool_size; i++) {
+      cmd = val_pe_pool_cmd(i);
+      cmd->exit = 1;
+      cmd->seq++;
+      val_data_cache_ops_by_va((addr_t)cmd, CLEAN_AND_INVALIDATE);
+  }
+  ArmCallSEV();
+
+  for (i = 0; i < g_pe_pool_size; i++) {
+      if (!val_wait_until(val_pe_pool_exited, (void *)val_pe_pool_ack(i),
+                          VAL_WAIT_PE_STATE_TIMEOUT_US)) {
+          val_print(ACS_PRINT_WARN, "\n       PE pool: PE index %d did not exit", i);
+          stuck = 1;
+      }
+  }
+
+  /* A PE still running a payload may write its mailbox later, keep it allocated */
+  if (!stuck)
+      pal_mem_free_aligned((void *)g_pe_pool);
+
+  g_pe_pool = NULL;
+  g_pe_pool_size = 0;
+  val_data_cache_ops_by_va((addr_t)&g_pe_pool, CLEAN_AND_INVALIDATE);
+  val_data_cache_ops_by_va((addr_t)&g_pe_pool_size, CLEAN_AND_INVALIDATE);
+}
+#endif
 
 /**
   @brief   'C' Entry point for Secondary PE.
@@ -234,10 +761,17 @@ val_test_entry(void)
   uint64_t test_arg;
   ARM_SMC_ARGS smc_args;
   void (*vector)(uint64_t args);
+  uint32_t index;
 
-  val_get_test_data(val_pe_get_index_mpid(val_pe_get_mpid()), (uint64_t *)&vector, &test_arg);
+  index = val_pe_get_index_mpid(val_pe_get_mpid());
+  val_get_test_data(index, (uint64_t *)&vector, &test_arg);
   vector(test_arg);
 
+#ifndef TARGET_LINUX
+  /* With the worker pool enabled, stay parked until the pool is released */
+  val_pe_pool_worker(index);
+#endif
+
   // We have completed our TEST code. So, switch off the PE now
   smc_args.Arg0 = ARM_SMC_ID_PSCI_CPU_OFF;
   smc_args.Arg1 = val_pe_get_mpid();
@@ -245,6 +779,45 @@ val_test_entry(void)
 }
 
 
+#ifndef TARGET_LINUX
+/* Payload handed to val_pe_try_execute through val_wait_until */
+typedef struct {
+  uint32_t index;
+  void     (*payload)(void);
+  uint64_t test_input;
+  uint32_t dispatched;
+} VAL_PE_EXEC_REQ;
+
+/**
+  @brief   One attempt to start a payload on a PE, through the worker pool or
+           PSCI_CPU_ON. Completion check for val_wait_until.
+  @param   arg - VAL_PE_EXEC_REQ of the payload
+  @return  0 if the PE is still on and the attempt must be retried
+**/
+static uint32_t
+val_pe_try_execute(void *arg)
+{
+  VAL_PE_EXEC_REQ *req = (VAL_PE_EXEC_REQ *)arg;
+
+  /* A PE parked in the worker pool takes the payload through its mailbox */
+  if (val_pe_pool_dispatch(req->index, req->payload, req->test_input)) {
+      req->dispatched = 1;
+      return 1;
+  }
+
+  g_smc_args.Arg0 = ARM_SMC_ID_PSCI_CPU_ON_AARCH64;
+
+  /* Set the TEST function pointer in a shared memory location. This location is
+     read by the Secondary PE (val_test_entry()) and executes the test. */
+  g_smc_args.Arg1 = val_pe_get_mpid_index(req->index);
+
+  val_set_test_data(req->index, (uint64_t)req->payload, req->test_input);
+  pal_pe_execute_payload(&g_smc_args);
+
+  return (g_smc_args.Arg0 != (uint64_t)ARM_SMC_PSCI_RET_ALREADY_ON);
+}
+#endif
+
 /**
   @brief   This API initiates the execution of a test on a secondary PE.
            Uses PSCI_CPU_ON to wake a secondary PE
@@ -259,13 +832,27 @@ void
 val_execute_on_pe(uint32_t index, void (*payload)(void), uint64_t test_input)
 {
 
+#ifndef TARGET_LINUX
+  VAL_PE_EXEC_REQ req;
+#else
   int timeout = TIMEOUT_LARGE;
+#endif
   if (index > g_pe_info_table->header.num_of_pe) {
       val_print(ACS_PRINT_ERR, "Input Index exceeds Num of PE %x\n", index);
       val_report_status(index, RESULT_FAIL(0, 0xFF), NULL);
       return;
   }
 
+#ifndef TARGET_LINUX
+  /* A PE still on from its previous payload is retried until it powers off */
+  req.index = index;
+  req.payload = payload;
+  req.test_input = test_input;
+  req.dispatched = 0;
+  val_wait_until(val_pe_try_execute, (void *)&req, VAL_WAIT_PE_STATE_TIMEOUT_US);
+  if (req.dispatched)
+      return;
+#else
   do {
       g_smc_args.Arg0 = ARM_SMC_ID_PSCI_CPU_ON_AARCH64;
 
@@ -277,6 +864,7 @@ val_execute_on_pe(uint32_t index, void (*payload)(void), uint64_t test_input)
       pal_pe_execute_payload(&g_smc_args);
 
   } while (g_smc_args.Arg0 == (uint64_t)ARM_SMC_PSCI_RET_ALREADY_ON && timeout--);
+#endif
 
   if (g_smc_args.Arg0 == (uint64_t)ARM_SMC_PSCI_RET_ALREADY_ON) {
       val_print(ACS_PRINT_ERR, "\n       PSCI_CPU_ON: cpu already on", 0);
@@ -389,6 +977,9 @@ val_pe_default_esr(uint64_t interrupt_type, void *context)
     if (pal_target_is_dt()) {
       val_print(ACS_PRINT_WARN, "\n        FAR reported = 0x%llx", bsa_gic_get_far());
       val_print(ACS_PRINT_WARN, "\n        ESR reported = 0x%llx", bsa_gic_get_esr());
+      /* The log staging buffer is not shared safely, only the primary PE flushes it */
+      if (index == val_pe_get_primary_index())
+          val_log_flush();
       val_set_status(index, RESULT_FAIL(0, 1));
       val_pe_update_elr(context, g_exception_ret_addr);
       return;
@@ -401,6 +992,8 @@ val_pe_default_esr(uint64_t interrupt_type, void *context)
       val_print(ACS_PRINT_WARN, "\n        FAR reported = 0x%llx", val_pe_get_far(context));
       val_print(ACS_PRINT_WARN, "\n        ESR reported = 0x%llx", val_pe_get_esr(context));
     }
+    if (index == val_pe_get_primary_index())
+        val_log_flush();
 #endif
 
     val_set_status(index, RESULT_FAIL(0, 1));
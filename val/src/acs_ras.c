@@ -23,6 +23,59 @@
 
 static RAS_INFO_TABLE  *g_ras_info_table;
 static RAS2_INFO_TABLE *g_ras2_info_table;
+static RAS_NODE_ACCESSOR *g_ras_node_acc;
+
+/**
+  @brief   Resolve the register accessor of a RAS node from the RAS info table.
+  @param   node_index  RAS Node Index
+  @param   acc         Accessor to fill
+  @return  None
+**/
+static void
+val_ras_resolve_accessor(uint32_t node_index, RAS_NODE_ACCESSOR *acc)
+{
+  RAS_INTERFACE_INFO *intf = &g_ras_info_table->node[node_index].intf_info;
+
+  acc->is_mmio = (intf->intf_type == RAS_INTF_TYPE_MMIO);
+  acc->base = acc->is_mmio ? intf->base_addr : 0;
+  acc->start_rec_index = intf->start_rec_index;
+  acc->num_err_rec = intf->num_err_rec;
+  acc->valid_rec_mask = ~intf->err_rec_implement;
+}
+
+/**
+  @brief   Return the accessor of a RAS node. Accessors are resolved for all nodes when the
+           info table is created; if that allocation failed the scratch copy is filled.
+  @param   node_index  RAS Node Index
+  @param   scratch     Accessor filled when no cached accessor is available
+  @return  Pointer to the accessor
+**/
+static RAS_NODE_ACCESSOR *
+val_ras_node_accessor(uint32_t node_index, RAS_NODE_ACCESSOR *scratch)
+{
+  if (g_ras_node_acc != NULL)
+      return &g_ras_node_acc[node_index];
+
+  val_ras_resolve_accessor(node_index, scratch);
+  return scratch;
+}
+
+/**
+  @brief   Check the implemented bit of an error record. Like the AEST bitmap, bit n
+           is for the n-th record of the node. Records beyond the 64 bit implemented
+           bitmap are treated as implemented.
+  @param   acc          Accessor of the RAS node
+  @param   rec_offset   Error record index relative to the node's start_rec_index
+  @return  1 if the record is implemented, 0 otherwise
+**/
+static uint32_t
+val_ras_rec_implemented(RAS_NODE_ACCESSOR *acc, uint32_t rec_offset)
+{
+  if (rec_offset >= 64)
+      return 1;
+
+  return (acc->valid_rec_mask >> rec_offset) & 0x1;
+}
 
 
 /**
@@ -49,6 +102,18 @@ val_ras_create_info_table(uint64_t *ras_info_table)
   val_print(ACS_PRINT_TEST, " RAS_INFO: Number of RAS nodes        : %4d\n",
                            g_ras_info_table->num_nodes);
 
+  /* Resolve register accessors up front, register accesses fall back to the
+     info table if this fails */
+  if (g_ras_info_table->num_nodes) {
+      g_ras_node_acc = pal_mem_alloc(g_ras_info_table->num_nodes * sizeof(RAS_NODE_ACCESSOR));
+      if (g_ras_node_acc != NULL) {
+          uint32_t i;
+
+          for (i = 0; i < g_ras_info_table->num_nodes; i++)
+              val_ras_resolve_accessor(i, &g_ras_node_acc[i]);
+      }
+  }
+
   return ACS_STATUS_PASS;
 }
 
@@ -58,6 +123,11 @@ val_ras_create_info_table(uint64_t *ras_info_table)
 void
 val_ras_free_info_table(void)
 {
+    if (g_ras_node_acc != NULL) {
+        pal_mem_free((void *)g_ras_node_acc);
+        g_ras_node_acc = NULL;
+    }
+
     if (g_ras_info_table != NULL) {
         pal_mem_free((void *)g_ras_info_table);
         g_ras_info_table = NULL;
@@ -366,28 +436,26 @@ val_ras2_get_mem_info(RAS2_MEM_INFO_e type, uint32_t index)
 uint64_t
 val_ras_reg_read(uint32_t node_index, uint32_t reg, uint32_t err_rec_idx)
 {
+  RAS_NODE_ACCESSOR scratch, *acc;
   uint64_t base, value = INVALID_RAS_REG_VAL;
   uint32_t start_rec_index, offset = 0;
-  uint64_t num_err_recs, err_rec_impl_bitmap;
 
-  start_rec_index = g_ras_info_table->node[node_index].intf_info.start_rec_index;
+  acc = val_ras_node_accessor(node_index, &scratch);
+  start_rec_index = acc->start_rec_index;
 
   /* err_rec_idx = 0 means the first error record of the node */
   if (err_rec_idx == 0)
       err_rec_idx = start_rec_index;
 
   /* Check if err record index is valid */
-  val_ras_get_info(RAS_INFO_NUM_ERR_REC, node_index, &num_err_recs);
-  if ((err_rec_idx - start_rec_index) >= num_err_recs) {
+  if ((err_rec_idx - start_rec_index) >= acc->num_err_rec) {
       val_print(ACS_PRINT_ERR,
                 "\n       RAS_REG_READ : Invalid Input error record index(%d)\n", err_rec_idx);
       return INVALID_RAS_REG_VAL;
   }
 
   /* check if err record is implemented for given node index*/
-  val_ras_get_info(RAS_INFO_ERR_REC_IMP, node_index, &err_rec_impl_bitmap);
-
-  if ((err_rec_impl_bitmap >> err_rec_idx) & 0x1) {
+  if (!val_ras_rec_implemented(acc, err_rec_idx - start_rec_index)) {
       val_print(ACS_PRINT_ERR,
                 "\n       RAS_REG_READ : Error record index(%d) is unimplemented ", err_rec_idx);
       val_print(ACS_PRINT_ERR,
@@ -395,11 +463,11 @@ val_ras_reg_read(uint32_t node_index, uint32_t reg, uint32_t err_rec_idx)
       return INVALID_RAS_REG_VAL;
   }
 
-  if (g_ras_info_table->node[node_index].intf_info.intf_type == RAS_INTF_TYPE_MMIO) {
+  if (acc->is_mmio) {
       /* MMIO based RAS register read */
 
       /* Get the Base address for this node */
-      base = g_ras_info_table->node[node_index].intf_info.base_addr;
+      base = acc->base;
 
       switch (reg) {
       case RAS_ERR_FR:
@@ -517,16 +585,18 @@ val_ras_reg_read(uint32_t node_index, uint32_t reg, uint32_t err_rec_idx)
 void
 val_ras_reg_write(uint32_t node_index, uint32_t reg, uint64_t write_data)
 {
+  RAS_NODE_ACCESSOR scratch, *acc;
   uint64_t base;
   uint32_t rec_index, offset = 0;
 
-  rec_index = g_ras_info_table->node[node_index].intf_info.start_rec_index;
+  acc = val_ras_node_accessor(node_index, &scratch);
+  rec_index = acc->start_rec_index;
 
-  if (g_ras_info_table->node[node_index].intf_info.intf_type == RAS_INTF_TYPE_MMIO) {
+  if (acc->is_mmio) {
     /* MMIO Based Write */
 
     /* Get the Base address for this node */
-    base = g_ras_info_table->node[node_index].intf_info.base_addr;
+    base = acc->base;
 
     switch (reg) {
     case RAS_ERR_FR:
@@ -574,6 +644,56 @@ val_ras_reg_write(uint32_t node_index, uint32_t reg, uint64_t write_data)
   }
 }
 
+/**
+  @brief   Read ERR<n>STATUS of every implemented error record of a RAS node and report
+           the records with all bits of status_mask set. Unimplemented records are not
+           accessed. A read returning all ones, which ERR<n>STATUS cannot hold as it has
+           RES0 bits, is counted as a failed read and not matched.
+           1. Caller       -  Test layer.
+           2. Prerequisite -  val_ras_create_info_table.
+  @param   node_index   RAS Node Index
+  @param   status_mask  ERR<n>STATUS bits that must all be set, e.g. ERR_STATUS_V_MASK
+  @param   rec_bitmap   Bit n set for matching record start_rec_index + n (n < 64)
+  @return  Number of error records whose ERR<n>STATUS read failed
+**/
+uint32_t
+val_ras_scan_err_status(uint32_t node_index, uint64_t status_mask, uint64_t *rec_bitmap)
+{
+  RAS_NODE_ACCESSOR scratch, *acc;
+  uint64_t value;
+  uint32_t n, rec_index, failed = 0;
+
+  acc = val_ras_node_accessor(node_index, &scratch);
+
+  *rec_bitmap = 0;
+
+  for (n = 0; n < acc->num_err_rec; n++) {
+      if (!val_ras_rec_implemented(acc, n))
+          continue;
+
+      rec_index = acc->start_rec_index + n;
+      if (acc->is_mmio)
+          value = val_mmio_read64(acc->base + ERR_STATUS_OFFSET + (64 * rec_index));
+      else {
+          AA64WriteErrSelr1(rec_index);
+          value = AA64ReadErrStatus1();
+      }
+
+      if (value == ~0ull) {
+          val_print(ACS_PRINT_ERR,
+                    "\n       RAS_SCAN : ERR<%d>STATUS read failed ", rec_index);
+          val_print(ACS_PRINT_ERR, "for node with index: %d", node_index);
+          failed++;
+          continue;
+      }
+
+      if (((value & status_mask) == status_mask) && (n < 64))
+          *rec_bitmap |= (0x1ull << n);
+  }
+
+  return failed;
+}
+
 /**
   @brief  Function for setting up the Error Environment
 
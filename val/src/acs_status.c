@@ -100,8 +100,7 @@ val_set_status(uint32_t index, uint32_t status)
 {
   volatile VAL_SHARED_MEM_t *mem;
 
-  mem = (VAL_SHARED_MEM_t *) pal_mem_get_shared_addr();
-  mem = mem + index;
+  mem = val_shared_mem_entry(index);
   mem->status = status;
 
   val_data_cache_ops_by_va((addr_t)&mem->status, CLEAN_AND_INVALIDATE);
@@ -119,8 +118,7 @@ val_get_status(uint32_t index)
 {
   volatile VAL_SHARED_MEM_t *mem;
 
-  mem = (VAL_SHARED_MEM_t *) pal_mem_get_shared_addr();
-  mem = mem + index;
+  mem = val_shared_mem_entry(index);
 
   val_data_cache_ops_by_va((addr_t)&mem->status, INVALIDATE);
 
@@ -21,9 +21,15 @@
 #include "driver/gic/acs_exception.h"
 #include "include/pal_interface.h"
 #include "include/val_interface.h"
+#ifndef TARGET_LINUX
+#include "include/acs_timer_support.h"
+#endif
 
 uint32_t g_override_skip;
 
+/* Byte spacing of the per-PE records in the shared memory region */
+static uint32_t g_shared_mem_stride = sizeof(VAL_SHARED_MEM_t);
+
 /**
   @brief  This API calls PAL layer to print a formatted string
           to the output console.
@@ -80,6 +86,102 @@ val_print_test_start(char8_t *string)
   val_print(ACS_PRINT_TEST, " tests ***\n", 0);
 }
 
+#ifndef TARGET_LINUX
+/**
+  @brief  Write any log output staged by the PAL to the log file
+          1. Caller       - Application layer, VAL
+          2. Prerequisite - None.
+
+  @param  None
+
+  @return None
+**/
+void
+val_log_flush(void)
+{
+  pal_log_flush();
+}
+
+/* Log sink mode selected by the application, restored by val_log_benchmark */
+static uint32_t g_log_mode = PAL_LOG_UNBUFFERED;
+
+/**
+  @brief  Select how print output reaches the log file, see pal_log_set_mode.
+          Staged output is flushed first.
+          1. Caller       - Application layer
+          2. Prerequisite - None.
+
+  @param  mode  PAL_LOG_UNBUFFERED (default), PAL_LOG_BUFFERED or PAL_LOG_CONSOLE
+
+  @return None
+**/
+void
+val_log_set_mode(uint32_t mode)
+{
+  g_log_mode = mode;
+  pal_log_set_mode(mode);
+}
+
+/**
+  @brief  Time log lines through each log sink mode and report the cost per
+          line: console only, batched file writes and one file write per print
+          fragment. The timed lines are labelled as benchmark output so they
+          cannot be read as test results, and the timings are printed to the
+          console only. The selected mode is restored afterwards.
+          1. Caller       - Application layer
+          2. Prerequisite - val_timer_create_info_table
+
+  @param  num_lines  Number of lines printed per mode
+
+  @return None
+**/
+void
+val_log_benchmark(uint32_t num_lines)
+{
+  uint32_t mode[] = {PAL_LOG_CONSOLE, PAL_LOG_BUFFERED, PAL_LOG_UNBUFFERED};
+  char8_t *name[] = {"\n Log sink console", "\n Log sink buffered file",
+                     "\n Log sink unbuffered file"};
+  uint64_t ns_per_line[sizeof(mode) / sizeof(mode[0])];
+  uint64_t start, ticks, freq;
+  uint32_t i, j;
+
+  freq = val_get_counter_frequency();
+  if (!num_lines || !freq)
+      return;
+
+  /* The timed lines must reach the log sink to be measured */
+  if (g_print_level > ACS_PRINT_TEST) {
+      val_print(ACS_PRINT_WARN, "\n Log sink benchmark needs print level 3 or lower", 0);
+      return;
+  }
+
+  for (i = 0; i < sizeof(mode) / sizeof(mode[0]); i++) {
+      pal_log_set_mode(mode[i]);
+      start = ArmReadCntPct();
+      for (j = 0; j < num_lines; j++) {
+          /* Four fragments per line, like a test result line */
+          val_print(ACS_PRINT_TEST, "\n  [log benchmark] line %d", j);
+          val_print(ACS_PRINT_TEST, " of synthetic output,", 0);
+          val_print(ACS_PRINT_TEST, " mode %d", mode[i]);
+          val_print(ACS_PRINT_TEST, " - not a test result", 0);
+      }
+      pal_log_flush();
+      ticks = ArmReadCntPct() - start;
+      ns_per_line[i] = ((ticks / num_lines) * 1000000000) / freq;
+  }
+
+  /* Keep the timings out of the log file */
+  pal_log_set_mode(PAL_LOG_CONSOLE);
+  for (i = 0; i < sizeof(mode) / sizeof(mode[0]); i++) {
+      val_print(ACS_PRINT_TEST, name[i], 0);
+      val_print(ACS_PRINT_TEST, ": %ld ns per line", ns_per_line[i]);
+  }
+  val_print(ACS_PRINT_TEST, "\n", 0);
+
+  pal_log_set_mode(g_log_mode);
+}
+#endif
+
 /**
   @brief  This API calls PAL layer to print tests status
           to the output console.
@@ -386,9 +488,33 @@ val_initialize_test(uint32_t test_num, char8_t *desc, uint32_t num_pe)
 void
 val_allocate_shared_mem()
 {
+  uint32_t granule = sizeof(VAL_SHARED_MEM_t);
+
+#ifndef TARGET_LINUX
+  granule = val_pe_cache_wb_granule();
+#endif
 
-  pal_mem_allocate_shared(val_pe_get_num(), sizeof(VAL_SHARED_MEM_t));
+  g_shared_mem_stride = ((sizeof(VAL_SHARED_MEM_t) + granule - 1) / granule) * granule;
+  val_data_cache_ops_by_va((addr_t)&g_shared_mem_stride, CLEAN_AND_INVALIDATE);
 
+  pal_mem_allocate_shared(val_pe_get_num(), g_shared_mem_stride);
+  val_print(ACS_PRINT_DEBUG, "\n Shared memory entry size %d", g_shared_mem_stride);
+}
+
+/**
+  @brief  Return the shared memory record of a PE
+          1. Caller       - VAL
+          2. Prerequisite - val_allocate_shared_mem
+
+  @param  index  PE index
+
+  @return Pointer to the PE's record
+**/
+volatile VAL_SHARED_MEM_t *
+val_shared_mem_entry(uint32_t index)
+{
+  return (volatile VAL_SHARED_MEM_t *)(pal_mem_get_shared_addr() +
+                                       (uint64_t)index * g_shared_mem_stride);
 }
 
 /**
@@ -431,8 +557,7 @@ val_set_test_data(uint32_t index, uint64_t addr, uint64_t test_data)
       return;
   }
 
-  mem = (VAL_SHARED_MEM_t *)pal_mem_get_shared_addr();
-  mem = mem + index;
+  mem = val_shared_mem_entry(index);
 
   mem->data0 = addr;
   mem->data1 = test_data;
@@ -466,8 +591,7 @@ val_get_test_data(uint32_t index, uint64_t *data0, uint64_t *data1)
       return;
   }
 
-  mem = (VAL_SHARED_MEM_t *) pal_mem_get_shared_addr();
-  mem = mem + index;
+  mem = val_shared_mem_entry(index);
 
   val_data_cache_ops_by_va((addr_t)&mem->data0, INVALIDATE);
   val_data_cache_ops_by_va((addr_t)&mem->data1, INVALIDATE);
@@ -477,6 +601,31 @@ val_get_test_data(uint32_t index, uint64_t *data0, uint64_t *data1)
 
 }
 
+#ifndef TARGET_LINUX
+/* Timeout of val_wait_for_test_completion, in microseconds */
+#define VAL_TEST_COMPLETION_TIMEOUT  VAL_WAIT_TEST_TIMEOUT_US
+
+/**
+  @brief  Completion check for val_wait_until, all PE statuses left pending
+  @param  arg  Number of PEs
+  @return 1 if no PE status is pending
+**/
+static uint32_t
+val_test_status_done(void *arg)
+{
+  uint32_t i, num_pe = (uint32_t)(uint64_t)arg;
+
+  for (i = 0; i < num_pe; i++)
+      if (IS_RESULT_PENDING(val_get_status(i)))
+          return 0;
+
+  return 1;
+}
+#else
+/* Timeout of val_wait_for_test_completion, in status polls */
+#define VAL_TEST_COMPLETION_TIMEOUT  TIMEOUT_LARGE
+#endif
+
 /**
   @brief  This function will wait for all PEs to report their status
           or we timeout and set a failure for the PE which timed-out
@@ -485,13 +634,14 @@ val_get_test_data(uint32_t index, uint64_t *data0, uint64_t *data1)
 
   @param test_num  Unique test number
   @param num_pe    Number of PE who are executing this test
-  @param timeout   integer value ob expiry the API will timeout and return
+  @param timeout   Time in microseconds after which the API returns, a poll count
+                   for the Linux driver
 
   @return        None
  **/
 
 static void
-val_wait_for_test_completion(uint32_t test_num, uint32_t num_pe, uint32_t timeout)
+val_wait_for_test_completion(uint32_t test_num, uint32_t num_pe, uint64_t timeout)
 {
 
   uint32_t i = 0, j = 0;
@@ -500,6 +650,19 @@ val_wait_for_test_completion(uint32_t test_num, uint32_t num_pe, uint32_t timeou
   if (num_pe == 1)
       return;
 
+#ifndef TARGET_LINUX
+  /* PEs running from the worker pool report completion through their mailbox */
+  val_pe_pool_wait(num_pe, timeout);
+
+  if (val_wait_until(val_test_status_done, (void *)(uint64_t)num_pe, timeout))
+      return;
+
+  for (i = 0; i < num_pe; i++)
+      if (IS_RESULT_PENDING(val_get_status(i)))
+          j = i+1;
+  if (!j)
+      return;
+#else
   while(--timeout)
   {
       j = 0;
@@ -513,6 +676,7 @@ val_wait_for_test_completion(uint32_t test_num, uint32_t num_pe, uint32_t timeou
       if (!j)
           return;
   }
+#endif
   //We are here if we timed-out, set the last index PE as failed
   val_set_status(j-1, RESULT_FAIL(test_num, 0xF));
 }
@@ -546,8 +710,73 @@ val_run_test_payload(uint32_t test_num, uint32_t num_pe, void (*payload)(void),
           val_execute_on_pe(i, payload, test_input);
   }
 
-  val_wait_for_test_completion(test_num, num_pe, TIMEOUT_LARGE);
+  val_wait_for_test_completion(test_num, num_pe, VAL_TEST_COMPLETION_TIMEOUT);
+}
+
+#ifndef TARGET_LINUX
+/**
+  @brief  Payload for val_shared_mem_stress. Issues back-to-back status updates
+          for the calling PE and finishes with a PASS status, which a lost
+          update would overwrite with a stale PENDING value.
+**/
+static void
+val_shared_mem_stress_payload(void)
+{
+  uint32_t index = val_pe_get_index_mpid(val_pe_get_mpid());
+  uint32_t i;
+
+  for (i = 0; i < VAL_SHARED_MEM_STRESS_UPDATES; i++)
+      val_set_status(index, RESULT_PENDING(0) | (i & STATUS_MASK));
+
+  val_set_status(index, RESULT_PASS(0, 0));
+}
+
+/**
+  @brief  Stress the per-PE shared status records by updating them from all
+          PEs at once, and report the update rate and any lost updates.
+          Powers on every secondary PE, so it only runs when requested.
+          1. Caller       - Application layer
+          2. Prerequisite - val_allocate_shared_mem, val_pe_create_info_table
+
+  @param  num_pe  Number of PEs taking part
+
+  @return None
+**/
+void
+val_shared_mem_stress(uint32_t num_pe)
+{
+  uint32_t my_index = val_pe_get_index_mpid(val_pe_get_mpid());
+  uint32_t lost = 0;
+  uint64_t start, ticks, freq;
+  uint32_t i;
+
+  for (i = 0; i < num_pe; i++)
+      val_set_status(i, RESULT_PENDING(0));
+
+  start = ArmReadCntPct();
+  for (i = 0; i < num_pe; i++) {
+      if (i != my_index)
+          val_execute_on_pe(i, val_shared_mem_stress_payload, 0);
+  }
+  val_shared_mem_stress_payload();
+  val_wait_for_test_completion(0, num_pe, VAL_TEST_COMPLETION_TIMEOUT);
+  ticks = ArmReadCntPct() - start;
+
+  for (i = 0; i < num_pe; i++) {
+      if (!IS_TEST_PASS(val_get_status(i)))
+          lost++;
+  }
+
+  freq = ArmReadCntFrq();
+  val_print(ACS_PRINT_INFO, "\n Shared status stress: PEs %d", num_pe);
+  val_print(ACS_PRINT_INFO, ", updates per PE %d", VAL_SHARED_MEM_STRESS_UPDATES);
+  if (ticks && freq)
+      val_print(ACS_PRINT_INFO, ", updates/s %ld",
+                ((uint64_t)num_pe * (VAL_SHARED_MEM_STRESS_UPDATES + 1) * freq) / ticks);
+  if (lost)
+      val_print(ACS_PRINT_WARN, "\n Shared status stress: %d PEs did not end with PASS", lost);
 }
+#endif
 
 /**
   @brief  This API Executes the payload function on primary PE with test specific argument as input
@@ -18,6 +18,7 @@
 #include "include/acs_val.h"
 #include "include/acs_timer_support.h"
 #include "include/acs_common.h"
+#include "include/acs_pe.h"
 
 /**
   @brief This API is used to get the effective HCR_EL2.E2H
@@ -216,3 +217,140 @@ ArmArchTimerWriteReg (
       val_print(ACS_PRINT_TEST, "Unknown ARM Generic Timer register %x.\n ", Reg);
     }
 }
+
+/**
+  @brief   Enable the generic timer event stream for the current exception
+           level, so that WFE based waits are woken periodically even when
+           the event they wait for never arrives.
+
+  @param   evnti  Counter bit whose transitions generate the events, the
+                  period is 2^(evnti + 1) counter ticks
+
+  @return  Previous timer control value, to be passed to
+           val_timer_event_stream_restore
+**/
+uint64_t
+val_timer_event_stream_enable(uint32_t evnti)
+{
+  uint64_t ctl, val;
+  uint64_t el = AA64ReadCurrentEL() & AARCH64_EL_MASK;
+
+  ctl = (el == AARCH64_EL2) ? ArmReadCnthCtl() : ArmReadCntkCtl();
+
+  val = (ctl & ~(CNTCTL_EVNTI_MASK | CNTCTL_EVNTDIR)) | CNTCTL_EVNTEN |
+        (((uint64_t)evnti << CNTCTL_EVNTI_SHIFT) & CNTCTL_EVNTI_MASK);
+
+  if (el == AARCH64_EL2)
+      ArmWriteCnthCtl(val);
+  else
+      ArmWriteCntkCtl(val);
+
+  return ctl;
+}
+
+/**
+  @brief   Restore the timer control register saved by
+           val_timer_event_stream_enable
+
+  @param   ctl  Value returned by val_timer_event_stream_enable
+
+  @return  None
+**/
+void
+val_timer_event_stream_restore(uint64_t ctl)
+{
+  uint64_t el = AA64ReadCurrentEL() & AARCH64_EL_MASK;
+
+  if (el == AARCH64_EL2)
+      ArmWriteCnthCtl(ctl);
+  else
+      ArmWriteCntkCtl(ctl);
+}
+
+/**
+  @brief   Wait until a completion condition holds or a timeout expires. The
+           timeout is measured on the generic counter, so the wall time does
+           not depend on the PE speed. Between checks the PE sleeps in WFE,
+           woken by interrupts, SEV from other PEs or the timer event stream.
+
+  @param   done        Returns non-zero once the awaited condition holds
+  @param   arg         Passed to done
+  @param   timeout_us  Timeout in microseconds
+
+  @return  1 if the condition holds, 0 on timeout
+**/
+uint32_t
+val_wait_until(uint32_t (*done)(void *arg), void *arg, uint64_t timeout_us)
+{
+  uint64_t freq, ticks, start, ctl;
+  uint32_t status;
+
+  if (done(arg))
+      return 1;
+
+  /* CNTFRQ_EL0 directly, waits run before or without the timer info table.
+     An unprogrammed CNTFRQ_EL0 assumes the fastest architected rate, so
+     waits are stretched rather than cut short */
+  freq = ArmReadCntFrq();
+  if (freq == 0)
+      freq = VAL_WAIT_DEFAULT_FREQ;
+
+  if (timeout_us > (~0ull / freq))
+      ticks = ~0ull;
+  else
+      ticks = (timeout_us * freq) / VAL_WAIT_US_PER_SEC;
+
+  ctl = val_timer_event_stream_enable(VAL_WAIT_EVNTI);
+  start = ArmReadCntPct();
+
+  while (!(status = done(arg))) {
+      if ((ArmReadCntPct() - start) >= ticks)
+          break;
+      ArmCallWFE();
+  }
+
+  val_timer_event_stream_restore(ctl);
+  return status ? 1 : 0;
+}
+
+static uint32_t
+val_wait_flag_set(void *arg)
+{
+  return (*(volatile uint32_t *)arg != 0);
+}
+
+/**
+  @brief   Wait until a flag, typically set by an interrupt handler, is
+           non-zero or a timeout expires
+
+  @param   flag        Flag to wait on
+  @param   timeout_us  Timeout in microseconds
+
+  @return  1 if the flag was set, 0 on timeout
+**/
+uint32_t
+val_wait_for_flag(volatile uint32_t *flag, uint64_t timeout_us)
+{
+  return val_wait_until(val_wait_flag_set, (void *)flag, timeout_us);
+}
+
+static uint32_t
+val_wait_status_done(void *arg)
+{
+  return !IS_RESULT_PENDING(val_get_status((uint32_t)(uint64_t)arg));
+}
+
+/**
+  @brief   Wait until the status of a PE is no longer pending or a timeout
+           expires
+
+  @param   index       PE index whose status is checked
+  @param   timeout_us  Timeout in microseconds
+
+  @return  1 if the status left pending, 0 on timeout
+**/
+uint32_t
+val_wait_for_status(uint32_t index, uint64_t timeout_us)
+{
+  return val_wait_until(val_wait_status_done, (void *)(uint64_t)index, timeout_us);
+}